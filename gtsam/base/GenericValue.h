@@ -23,8 +23,10 @@
 #include <gtsam/base/types.h>
 #include <gtsam/base/Value.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <new>
 #include <typeinfo> // operator typeid
 
 #ifdef _WIN32
@@ -136,6 +138,28 @@ public:
       return traits<T>::Local(GenericValue<T>::value(), genericValue2.value());
     }
 
+    /// Size of this object, for contiguous storage in Values
+    size_t storageSize_() const override {
+      return sizeof(GenericValue);
+    }
+
+    /// Alignment of this object, for contiguous storage in Values
+    size_t storageAlignment_() const override {
+      return NeedsToAlign ? std::max<size_t>(alignof(GenericValue), 16)
+                          : alignof(GenericValue);
+    }
+
+    /// Copy-construct into pre-allocated storage
+    Value* cloneInto_(void* storage) const override {
+      return new (storage) GenericValue(*this);
+    }
+
+    /// Retract and construct the result in pre-allocated storage
+    Value* retractInto_(const Vector& delta, void* storage) const override {
+      return new (storage) GenericValue(
+          traits<T>::Retract(GenericValue<T>::value(), delta));
+    }
+
     /// Non-virtual version of retract
     GenericValue retract(const Vector& delta) const {
       return GenericValue(traits<T>::Retract(GenericValue<T>::value(), delta));
@@ -0,0 +1,50 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MemoryUsage.cpp
+ * @brief   Breakdown of the memory used by a data structure, by component
+ */
+
+#include <gtsam/base/MemoryUsage.h>
+
+#include <iostream>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void MemoryUsage::add(const std::string& prefix, const MemoryUsage& other) {
+  for (const auto& [component, bytes] : other.components_)
+    components_[prefix + "." + component] += bytes;
+}
+
+/* ************************************************************************* */
+size_t MemoryUsage::bytes(const std::string& component) const {
+  const auto it = components_.find(component);
+  return it == components_.end() ? 0 : it->second;
+}
+
+/* ************************************************************************* */
+size_t MemoryUsage::total() const {
+  size_t bytes = 0;
+  for (const auto& [component, componentBytes] : components_) bytes += componentBytes;
+  return bytes;
+}
+
+/* ************************************************************************* */
+void MemoryUsage::print(const std::string& s) const {
+  std::cout << s << (s.empty() ? "" : "\n");
+  for (const auto& [component, bytes] : components_)
+    std::cout << "  " << component << ": " << bytes << " bytes\n";
+  std::cout << "  total: " << total() << " bytes" << std::endl;
+}
+
+}  // namespace gtsam
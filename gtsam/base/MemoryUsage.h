@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MemoryUsage.h
+ * @brief   Breakdown of the memory used by a data structure, by component
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Bytes used by the components of a data structure, as returned by the
+ * memoryUsage() methods of e.g. Values and ISAM2.  Nested structures are added
+ * with a prefix, so component names look like "theta.gtsam::Pose3".  The
+ * numbers count the storage reserved by the containers and matrices, not the
+ * overhead of the heap allocator.
+ */
+class GTSAM_EXPORT MemoryUsage {
+ public:
+  /// Add \c bytes to \c component
+  void add(const std::string& component, size_t bytes) {
+    components_[component] += bytes;
+  }
+
+  /// Add all components of \c other, as "prefix.component"
+  void add(const std::string& prefix, const MemoryUsage& other);
+
+  /// Bytes used by \c component, 0 if there is no such component
+  size_t bytes(const std::string& component) const;
+
+  /// Total bytes used by all components
+  size_t total() const;
+
+  /// All components, in name order
+  const std::map<std::string, size_t>& components() const { return components_; }
+
+  /// Print the components and the total
+  void print(const std::string& s = "") const;
+
+ private:
+  std::map<std::string, size_t> components_;
+};
+
+}  // namespace gtsam
@@ -80,10 +80,14 @@ void SymmetricBlockMatrix::invertInPlace() {
 }
 
 /* ************************************************************************* */
-void SymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals) {
+void SymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals,
+                                           bool singlePrecision) {
   gttic(VerticalBlockMatrix_choleskyPartial);
   DenseIndex topleft = variableColOffsets_[blockStart_];
-  if (!gtsam::choleskyPartial(matrix_, offset(nFrontals) - topleft, topleft)) {
+  const size_t nFrontal = offset(nFrontals) - topleft;
+  if (!(singlePrecision
+            ? gtsam::choleskyPartialSinglePrecision(matrix_, nFrontal, topleft)
+            : gtsam::choleskyPartial(matrix_, nFrontal, topleft))) {
     throw CholeskyFailed();
   }
 }
@@ -121,6 +121,12 @@ namespace gtsam {
     /// Block count
     DenseIndex nBlocks() const { return nActualBlocks() - blockStart_; }
 
+    /// Bytes of heap storage used by the full matrix and the block offsets
+    size_t memoryUsage() const {
+      return matrix_.size() * sizeof(double) +
+             variableColOffsets_.capacity() * sizeof(DenseIndex);
+    }
+
     /// Number of dimensions for variable on this diagonal block.
     DenseIndex getDim(DenseIndex block) const {
       return calcIndices(block, block, 1, 1)[2];
@@ -236,6 +242,29 @@ namespace gtsam {
       }
     }
 
+    /// updateDiagonalBlock for an N*N block, with N known at compile time so the loops unroll.
+    template <int N, typename XprType>
+    void updateFixedDiagonalBlock(DenseIndex I, const XprType& xpr) {
+      auto dest = block_(I, I).template topLeftCorner<N, N>();
+      assert(block_(I, I).rows() == N);
+      for (DenseIndex col = 0; col < N; ++col) {
+        for (DenseIndex row = 0; row <= col; ++row) {
+          dest(row, col) += xpr(row, col);
+        }
+      }
+    }
+
+    /// updateOffDiagonalBlock for an M*N block, with M and N known at compile time.
+    template <int M, int N, typename XprType>
+    void updateFixedOffDiagonalBlock(DenseIndex I, DenseIndex J, const XprType& xpr) {
+      assert(I != J);
+      if (I < J) {
+        block_(I, J).template topLeftCorner<M, N>().noalias() += xpr;
+      } else {
+        block_(J, I).template topLeftCorner<N, M>().noalias() += xpr.transpose();
+      }
+    }
+
     /// @}
     /// @name Accessing the full matrix.
     /// @{
@@ -287,8 +316,10 @@ namespace gtsam {
      *   R'Sd = [A1'A2 A1'b]
      *   L'L is the augmented Hessian on the the separator x2
      * R and Sd can be interpreted as a GaussianConditional |R*x1 + S*x2 - d]^2
+     * If \c singlePrecision is true, the factorization is computed in single
+     * precision, see choleskyPartialSinglePrecision.
      */
-    void choleskyPartial(DenseIndex nFrontals);
+    void choleskyPartial(DenseIndex nFrontals, bool singlePrecision = false);
 
     /**
      * After partial Cholesky, we can optionally split off R and Sd, to be interpreted as
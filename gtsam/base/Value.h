@@ -77,6 +77,29 @@ namespace gtsam {
      */
     virtual Vector localCoordinates_(const Value& value) const = 0;
 
+    /** Size in bytes of the most-derived object, used by Values to store
+     * values of the same type contiguously.  A return value of 0 (the
+     * default) means the value does not support placement and is always
+     * allocated with clone_().
+     */
+    virtual size_t storageSize_() const { return 0; }
+
+    /** Alignment in bytes required by the most-derived object. */
+    virtual size_t storageAlignment_() const { return alignof(Value); }
+
+    /** Copy-construct this value into \c storage, which must hold at least
+     * storageSize_() bytes aligned to storageAlignment_().  The result must be
+     * destroyed by calling its destructor explicitly, *not* with deallocate_.
+     */
+    virtual Value* cloneInto_(void* /*storage*/) const { return nullptr; }
+
+    /** Placement version of retract_, constructing the result in \c storage.
+     * Same storage requirements as cloneInto_.
+     */
+    virtual Value* retractInto_(const Vector& /*delta*/, void* /*storage*/) const {
+      return nullptr;
+    }
+
     /** Assignment operator */
     virtual Value& operator=(const Value& /*rhs*/) {
       //needs a empty definition so recursion in implicit derived assignment operators work
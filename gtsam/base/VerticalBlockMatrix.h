@@ -120,6 +120,12 @@ namespace gtsam {
     /// Block count
     DenseIndex nBlocks() const { assertInvariants(); return variableColOffsets_.size() - 1 - blockStart_; }
 
+    /// Bytes of heap storage used by the full matrix and the block offsets
+    size_t memoryUsage() const {
+      return matrix_.size() * sizeof(double) +
+             variableColOffsets_.capacity() * sizeof(DenseIndex);
+    }
+
     /** Access a single block in the underlying matrix with read/write access */
     Block operator()(DenseIndex block) { return range(block, block+1); }
 
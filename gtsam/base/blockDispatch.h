@@ -0,0 +1,59 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    blockDispatch.h
+ * @brief   Dispatch on common block dimensions, to use fixed-size Eigen kernels
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+#include <type_traits>
+
+namespace gtsam {
+namespace internal {
+
+/// A block dimension known at compile time, Eigen::Dynamic if it is not
+template <int N>
+using BlockDim = std::integral_constant<int, N>;
+
+/**
+ * Call \c f with BlockDim<dim> when \c dim is a common block dimension, and with
+ * BlockDim<Eigen::Dynamic> otherwise.  The common dimensions are 1 (scalars and the
+ * right-hand side), 2 (Point2), 3 (Point3, Rot3, Pose2), 6 (Pose3), 9 (NavState) and 15
+ * (NavState and IMU bias).  Eigen unrolls and vectorizes expressions on blocks whose size is
+ * known at compile time, so \c f can use fixed-size blocks in the first case.
+ */
+template <class FUNCTION>
+decltype(auto) DispatchBlockDim(DenseIndex dim, FUNCTION&& f) {
+  switch (dim) {
+    case 1: return f(BlockDim<1>());
+    case 2: return f(BlockDim<2>());
+    case 3: return f(BlockDim<3>());
+    case 6: return f(BlockDim<6>());
+    case 9: return f(BlockDim<9>());
+    case 15: return f(BlockDim<15>());
+    default: return f(BlockDim<Eigen::Dynamic>());
+  }
+}
+
+/// DispatchBlockDim on the dimensions of a block, calls f(BlockDim<rows>, BlockDim<cols>)
+template <class FUNCTION>
+decltype(auto) DispatchBlockDims(DenseIndex rows, DenseIndex cols, FUNCTION&& f) {
+  return DispatchBlockDim(rows, [&](auto m) {
+    return DispatchBlockDim(cols, [&](auto n) { return f(m, n); });
+  });
+}
+
+}  // namespace internal
+}  // namespace gtsam
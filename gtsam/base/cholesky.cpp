@@ -18,6 +18,7 @@
  */
 
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/blockDispatch.h>
 #include <gtsam/base/timing.h>
 
 #include <cmath>
@@ -104,28 +105,30 @@ pair<size_t, bool> choleskyCareful(Matrix& ATA, int order) {
 }
 
 /* ************************************************************************* */
-bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
-  gttic(choleskyPartial);
-  if (nFrontal == 0)
-    return true;
-
+// Partial Cholesky in the bottom-right corner of ABC, for any scalar type.  N is nFrontal
+// if it is known at compile time, in which case the frontal block is factored in registers.
+template <int N, class MATRIX>
+static bool choleskyPartialInPlace(MATRIX& ABC, size_t nFrontal, size_t topleft) {
+  typedef typename MATRIX::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, N, N> FrontalMatrix;
   assert(ABC.cols() == ABC.rows());
   assert(size_t(ABC.rows()) >= topleft);
   const size_t n = static_cast<size_t>(ABC.rows() - topleft);
   assert(nFrontal <= size_t(n));
 
   // Create views on blocks
-  auto A = ABC.block(topleft, topleft, nFrontal, nFrontal);
-  auto B = ABC.block(topleft, topleft + nFrontal, nFrontal, n - nFrontal);
+  auto A = ABC.template block<N, N>(topleft, topleft, nFrontal, nFrontal);
+  auto B = ABC.template block<N, Eigen::Dynamic>(topleft, topleft + nFrontal, nFrontal,
+                                                 n - nFrontal);
   auto C = ABC.block(topleft + nFrontal, topleft + nFrontal, n - nFrontal, n - nFrontal);
 
   // Compute Cholesky factorization A = R'*R, overwrites A.
   gttic(LLT);
-  Eigen::LLT<Matrix, Eigen::Upper> llt(A);
+  Eigen::LLT<FrontalMatrix, Eigen::Upper> llt(A);
   Eigen::ComputationInfo lltResult = llt.info();
   if (lltResult != Eigen::Success)
     return false;
-  auto R = A.triangularView<Eigen::Upper>();
+  auto R = A.template triangularView<Eigen::Upper>();
   R = llt.matrixU();
   gttoc(LLT);
 
@@ -138,7 +141,7 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   // Compute L = C - S' * S
   gttic(compute_L);
   if (nFrontal < n)
-    C.selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
+    C.template selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), Scalar(-1));
   gttoc(compute_L);
 
   // Check last diagonal element - Eigen does not check it
@@ -156,4 +159,32 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
     return true;
   }
 }
+
+/* ************************************************************************* */
+bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
+  gttic(choleskyPartial);
+  if (nFrontal == 0)
+    return true;
+  return internal::DispatchBlockDim(nFrontal, [&](auto n) {
+    return choleskyPartialInPlace<decltype(n)::value>(ABC, nFrontal, topleft);
+  });
+}
+
+/* ************************************************************************* */
+bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal, size_t topleft) {
+  gttic(choleskyPartialSinglePrecision);
+  if (nFrontal == 0)
+    return true;
+
+  // Factor a single-precision copy of the upper triangle of the active block
+  const size_t n = static_cast<size_t>(ABC.rows() - topleft);
+  auto active = ABC.bottomRightCorner(n, n);
+  Eigen::MatrixXf single(n, n);
+  single.triangularView<Eigen::Upper>() = active.cast<float>();
+  if (!choleskyPartialInPlace<Eigen::Dynamic>(single, nFrontal, 0))
+    return false;
+  active.triangularView<Eigen::Upper>() = single.cast<double>();
+  return true;
+}
+
 }  // namespace gtsam
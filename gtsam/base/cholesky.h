@@ -61,5 +61,13 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft=0);
 
+/**
+ * Partial Cholesky as choleskyPartial, but computed in single precision.  This
+ * halves the memory traffic of the factorization, at the cost of a factor that
+ * is only accurate to single precision, see GaussianBayesTree::refine.
+ */
+GTSAM_EXPORT bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal,
+                                                 size_t topleft = 0);
+
 }
 
@@ -66,6 +66,42 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialFixedSize) {
+  // Frontal dimensions with and without a fixed-size kernel
+  const Matrix M = Matrix::Random(20, 20);
+  const Matrix ABC = M.transpose() * M + 20 * Matrix::Identity(20, 20);
+  for (size_t nFrontal : {1, 2, 3, 4, 6, 9, 15}) {
+    Matrix RSL(ABC);
+    EXPECT(choleskyPartial(RSL, nFrontal, 2));
+    const size_t n = 18 - nFrontal;
+    const Matrix R = RSL.block(2, 2, nFrontal, nFrontal).triangularView<Eigen::Upper>();
+    const Matrix S = RSL.block(2, 2 + nFrontal, nFrontal, n);
+    const Matrix L = RSL.bottomRightCorner(n, n).selfadjointView<Eigen::Upper>();
+    const Matrix active = ABC.bottomRightCorner(18, 18);
+    EXPECT(assert_equal(Matrix(active.topLeftCorner(nFrontal, nFrontal)), R.transpose() * R, 1e-9));
+    EXPECT(assert_equal(Matrix(active.topRightCorner(nFrontal, n)), R.transpose() * S, 1e-9));
+    EXPECT(assert_equal(Matrix(active.bottomRightCorner(n, n)), L + S.transpose() * S, 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialSinglePrecision) {
+  Matrix ABC = (Matrix(5,5) <<
+                      4.0375,   3.4584,   3.5735,   2.4815,   2.1471,
+                          0.,   4.7267,   3.8423,   2.3624,   2.8091,
+                          0.,       0.,   5.1600,   2.0797,   3.4690,
+                          0.,       0.,       0.,   1.8786,   1.0535,
+                          0.,       0.,       0.,       0.,   3.0788).finished();
+
+  // Same factor as in double precision, to single precision
+  Matrix expected(ABC), actual(ABC);
+  EXPECT(choleskyPartial(expected, 2, 1));
+  EXPECT(choleskyPartialSinglePrecision(actual, 2, 1));
+  EXPECT(assert_equal(expected, actual, 1e-5));
+  EXPECT(actual.row(0) == ABC.row(0));
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
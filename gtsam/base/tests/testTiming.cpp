@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTiming.cpp
+ * @brief   Unit tests for the multi-threaded timing outline and trace export
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/timing.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace gtsam;
+
+namespace {
+void timedWork() {
+  gttic_(timedWork);
+  gttic_(timedInner);
+  gttoc_(timedInner);
+}
+
+size_t countOccurrences(const std::string& str, const std::string& pattern) {
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + 1))
+    ++count;
+  return count;
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(Timing, mergeThreads) {
+#ifdef GTSAM_USE_BOOST_FEATURES
+  tictoc_reset_();
+  {
+    gttic_(timedOuter);
+    timedWork();
+    // Work on another thread has no parent of its own, it is attached under
+    // the matching node in the main thread's outline when merging.
+    std::thread worker([] {
+      timedWork();
+      timedWork();
+    });
+    worker.join();
+  }
+
+  // The main thread's outline only contains its own calls
+  const internal::TimingOutline* work =
+      internal::gTimingRoot->find(internal::getTicTocID("timedWork"));
+  CHECK(work);
+  EXPECT_LONGS_EQUAL(1, work->n());
+
+  const std::shared_ptr<internal::TimingOutline> merged =
+      internal::mergedTimingRoot();
+  internal::TimingOutline* outer =
+      merged->find(internal::getTicTocID("timedOuter"));
+  CHECK(outer);
+  EXPECT_LONGS_EQUAL(1, outer->n());
+  const internal::TimingOutline* mergedWork =
+      outer->find(internal::getTicTocID("timedWork"));
+  CHECK(mergedWork);
+  EXPECT_LONGS_EQUAL(3, mergedWork->n());
+  const internal::TimingOutline* inner =
+      merged->find(internal::getTicTocID("timedInner"));
+  CHECK(inner);
+  EXPECT_LONGS_EQUAL(3, inner->n());
+  tictoc_reset_();
+#endif
+}
+
+/* ************************************************************************* */
+TEST(Timing, chromeTrace) {
+#ifdef GTSAM_USE_BOOST_FEATURES
+  tictoc_reset_();
+  timedWork();  // not recorded, tracing is off
+  tictoc_enableTrace_(true);
+  timedWork();
+  std::thread worker([] { timedWork(); });
+  worker.join();
+  tictoc_enableTrace_(false);
+
+  std::ostringstream os;
+  internal::writeChromeTrace(os);
+  const std::string trace = os.str();
+  EXPECT(trace.find("{\"traceEvents\":[") == 0);
+  EXPECT_LONGS_EQUAL(4, countOccurrences(trace, "\"ph\":\"X\""));
+  EXPECT_LONGS_EQUAL(2, countOccurrences(trace, "\"name\":\"timedWork\""));
+  EXPECT(countOccurrences(trace, "\"tid\":0}") >= 2);
+  EXPECT(trace.find("\"name\":\"main\"") != std::string::npos);
+  tictoc_reset_();
+#endif
+}
+
+/* ************************************************************************* */
+TEST(Timing, resetDropsExitedThreads) {
+#ifdef GTSAM_USE_BOOST_FEATURES
+  tictoc_reset_();
+  for (int i = 0; i < 3; ++i) {
+    std::thread worker([] { timedWork(); });
+    worker.join();
+  }
+  std::ostringstream before;
+  internal::writeChromeTrace(before);
+  EXPECT(countOccurrences(before.str(), "\"name\":\"worker ") >= 3);
+
+  // The workers have exited, so the reset releases their timing state
+  tictoc_reset_();
+  std::ostringstream after;
+  internal::writeChromeTrace(after);
+  EXPECT_LONGS_EQUAL(0, countOccurrences(after.str(), "\"name\":\"worker "));
+#endif
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
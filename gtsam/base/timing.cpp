@@ -19,14 +19,21 @@
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cassert>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 namespace internal {
@@ -38,6 +45,73 @@ GTSAM_EXPORT std::shared_ptr<TimingOutline> gTimingRoot(
     new TimingOutline("Total", getTicTocID("Total")));
 GTSAM_EXPORT std::weak_ptr<TimingOutline> gCurrentTimer(gTimingRoot);
 
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+/// A timed interval, recorded for trace export
+struct TraceEvent {
+  const char* label;
+  Clock::time_point start;
+  Clock::time_point end;
+};
+
+/// Per-thread timing state.  Only the owning thread modifies it while timing;
+/// the registry below keeps it alive for reporting after the thread exits,
+/// until the next resetTiming() drops it.
+struct ThreadTiming {
+  size_t index = 0;    ///< 0 for the main thread, increasing for others
+  bool isMain = false; ///< main thread records into gTimingRoot/gCurrentTimer
+  std::shared_ptr<TimingOutline> root;
+  std::weak_ptr<TimingOutline> current;
+  std::vector<Clock::time_point> starts; ///< start times of open tics
+  std::vector<TraceEvent> events;
+};
+
+std::mutex timingMutex;
+std::vector<std::shared_ptr<ThreadTiming> > threadTimings;
+size_t nextThreadIndex = 1;
+const std::thread::id mainThreadId = std::this_thread::get_id();
+std::atomic<bool> traceEnabled(false);
+Clock::time_point traceEpoch = Clock::now();
+
+std::shared_ptr<TimingOutline> newRoot() {
+  return std::make_shared<TimingOutline>("Total", getTicTocID("Total"));
+}
+
+ThreadTiming& thisThreadTiming() {
+  thread_local std::shared_ptr<ThreadTiming> timing;
+  if (!timing) {
+    timing = std::make_shared<ThreadTiming>();
+    timing->isMain = (std::this_thread::get_id() == mainThreadId);
+    if (!timing->isMain) {
+      timing->root = newRoot();
+      timing->current = timing->root;
+    }
+    std::unique_lock<std::mutex> lock(timingMutex);
+    timing->index = timing->isMain ? 0 : nextThreadIndex++;
+    threadTimings.push_back(timing);
+  }
+  return *timing;
+}
+
+std::shared_ptr<TimingOutline>& rootOf(ThreadTiming& timing) {
+  return timing.isMain ? gTimingRoot : timing.root;
+}
+
+std::weak_ptr<TimingOutline>& currentOf(ThreadTiming& timing) {
+  return timing.isMain ? gCurrentTimer : timing.current;
+}
+
+std::string jsonEscape(const char* str) {
+  std::string result;
+  for (; *str; ++str) {
+    if (*str == '"' || *str == '\\') result += '\\';
+    result += *str;
+  }
+  return result;
+}
+} // namespace
+
 /* ************************************************************************* */
 // Implementation of TimingOutline
 /* ************************************************************************* */
@@ -236,6 +310,158 @@ void TimingOutline::finishedIteration() {
 #endif
 }
 
+/* ************************************************************************* */
+std::shared_ptr<TimingOutline> TimingOutline::cloneTree() const {
+  std::shared_ptr<TimingOutline> result =
+      std::make_shared<TimingOutline>(label_, id_);
+  result->merge(*this, result);
+  return result;
+}
+
+/* ************************************************************************* */
+void TimingOutline::merge(const TimingOutline& other,
+    const std::weak_ptr<TimingOutline>& thisPtr) {
+#ifdef GTSAM_USE_BOOST_FEATURES
+  t_ += other.t_;
+  tWall_ += other.tWall_;
+  t2_ += other.t2_;
+  tIt_ += other.tIt_;
+  n_ += other.n_;
+  tMax_ = std::max(tMax_, other.tMax_);
+  if (tMin_ == 0 || (other.tMin_ != 0 && other.tMin_ < tMin_))
+    tMin_ = other.tMin_;
+  // Merge children in their original order, so printing order is preserved
+  std::map<size_t, std::shared_ptr<TimingOutline> > childOrder;
+  for(const ChildMap::value_type& child: other.children_)
+    childOrder[child.second->myOrder_] = child.second;
+  for(const auto& order_child: childOrder) {
+    const TimingOutline& otherChild = *order_child.second;
+    const std::shared_ptr<TimingOutline>& myChild =
+        child(otherChild.id_, otherChild.label_, thisPtr);
+    myChild->merge(otherChild, myChild);
+  }
+#endif
+}
+
+/* ************************************************************************* */
+TimingOutline* TimingOutline::find(size_t id) {
+  if (id_ == id)
+    return this;
+  // Search children in the order they were created
+  std::map<size_t, TimingOutline*> childOrder;
+  for(const ChildMap::value_type& child: children_)
+    childOrder[child.second->myOrder_] = child.second.get();
+  for(const auto& order_child: childOrder)
+    if (TimingOutline* found = order_child.second->find(id))
+      return found;
+  return nullptr;
+}
+
+/* ************************************************************************* */
+std::weak_ptr<TimingOutline>& currentTimer() {
+  return currentOf(thisThreadTiming());
+}
+
+/* ************************************************************************* */
+std::shared_ptr<TimingOutline> mergedTimingRoot() {
+  std::shared_ptr<TimingOutline> merged = gTimingRoot->cloneTree();
+#ifdef GTSAM_USE_BOOST_FEATURES
+  std::unique_lock<std::mutex> lock(timingMutex);
+  for(const std::shared_ptr<ThreadTiming>& timing: threadTimings) {
+    if (timing->isMain)
+      continue;
+    std::map<size_t, std::shared_ptr<TimingOutline> > childOrder;
+    for(const auto& child: timing->root->children_)
+      childOrder[child.second->myOrder_] = child.second;
+    for(const auto& order_child: childOrder) {
+      const TimingOutline& workerNode = *order_child.second;
+      // Attach under the matching node of the main thread, if there is one
+      TimingOutline* target = nullptr;
+      for(const auto& rootChild: merged->children_)
+        if ((target = rootChild.second->find(workerNode.id_)))
+          break;
+      if (target) {
+        target->merge(workerNode, target->parent_.lock()->children_[target->id_]);
+      } else {
+        const std::shared_ptr<TimingOutline>& node =
+            merged->child(workerNode.id_, workerNode.label_, merged);
+        node->merge(workerNode, node);
+      }
+    }
+  }
+#endif
+  return merged;
+}
+
+/* ************************************************************************* */
+void finishedIteration() {
+  gTimingRoot->finishedIteration();
+  std::unique_lock<std::mutex> lock(timingMutex);
+  for(const std::shared_ptr<ThreadTiming>& timing: threadTimings)
+    if (!timing->isMain)
+      timing->root->finishedIteration();
+}
+
+/* ************************************************************************* */
+void resetTiming() {
+  gTimingRoot = newRoot();
+  gCurrentTimer = gTimingRoot;
+  std::unique_lock<std::mutex> lock(timingMutex);
+  // Once its thread has exited, the registry holds the only reference to a
+  // ThreadTiming, and after the reset it would have nothing left to report.
+  threadTimings.erase(
+      std::remove_if(threadTimings.begin(), threadTimings.end(),
+                     [](const std::shared_ptr<ThreadTiming>& timing) {
+                       return timing.use_count() == 1;
+                     }),
+      threadTimings.end());
+  for(const std::shared_ptr<ThreadTiming>& timing: threadTimings) {
+    if (!timing->isMain) {
+      timing->root = newRoot();
+      timing->current = timing->root;
+    }
+    timing->starts.clear();
+    timing->events.clear();
+  }
+  traceEpoch = Clock::now();
+}
+
+/* ************************************************************************* */
+void setTraceEnabled(bool enabled) {
+  traceEnabled = enabled;
+}
+
+/* ************************************************************************* */
+void writeChromeTrace(std::ostream& os) {
+  std::unique_lock<std::mutex> lock(timingMutex);
+  auto micros = [](Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+  };
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize precision = os.precision();
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for(const std::shared_ptr<ThreadTiming>& timing: threadTimings) {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+       << timing->index << ",\"args\":{\"name\":\""
+       << (timing->isMain ? std::string("main")
+                          : "worker " + std::to_string(timing->index))
+       << "\"}}";
+    for(const TraceEvent& event: timing->events) {
+      os << ",\n{\"name\":\"" << jsonEscape(event.label)
+         << "\",\"cat\":\"gtsam\",\"ph\":\"X\",\"ts\":" << std::fixed
+         << std::setprecision(3) << micros(event.start - traceEpoch)
+         << ",\"dur\":" << micros(event.end - event.start)
+         << ",\"pid\":0,\"tid\":" << timing->index << "}";
+    }
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
 /* ************************************************************************* */
 size_t getTicTocID(const char *descriptionC) {
 // disable anything which refers to TimingOutline as well, for good measure
@@ -244,6 +470,8 @@ size_t getTicTocID(const char *descriptionC) {
   // Global (static) map from strings to ID numbers and current next ID number
   static size_t nextId = 0;
   static gtsam::FastMap<std::string, size_t> idMap;
+  static std::mutex idMutex;
+  std::unique_lock<std::mutex> lock(idMutex);
 
   // Retrieve or add this string
   auto it = idMap.find(description);
@@ -264,9 +492,12 @@ void tic(size_t id, const char *labelC) {
 // disable anything which refers to TimingOutline as well, for good measure
 #ifdef GTSAM_USE_BOOST_FEATURES
   const std::string label(labelC);
+  ThreadTiming& timing = thisThreadTiming();
+  std::weak_ptr<TimingOutline>& current = currentOf(timing);
   std::shared_ptr<TimingOutline> node = //
-      gCurrentTimer.lock()->child(id, label, gCurrentTimer);
-  gCurrentTimer = node;
+      current.lock()->child(id, label, current);
+  current = node;
+  timing.starts.push_back(traceEnabled ? Clock::now() : Clock::time_point());
   node->tic();
 #endif
 }
@@ -275,23 +506,40 @@ void tic(size_t id, const char *labelC) {
 void toc(size_t id, const char *label) {
 // disable anything which refers to TimingOutline as well, for good measure
 #ifdef GTSAM_USE_BOOST_FEATURES
-  std::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
+  ThreadTiming& timing = thisThreadTiming();
+  std::shared_ptr<TimingOutline> current(currentOf(timing).lock());
   if (id != current->id_) {
-    gTimingRoot->print();
+    rootOf(timing)->print();
     throw std::invalid_argument(
         "gtsam timing:  Mismatched tic/toc: gttoc(\"" + std::string(label) +
         "\") called when last tic was \"" + current->label_ + "\".");
   }
   if (!current->parent_.lock()) {
-    gTimingRoot->print();
+    rootOf(timing)->print();
     throw std::invalid_argument(
         "gtsam timing:  Mismatched tic/toc: extra gttoc(\"" + std::string(label) +
         "\"), already at the root");
   }
   current->toc();
-  gCurrentTimer = current->parent_;
+  currentOf(timing) = current->parent_;
+  if (!timing.starts.empty()) {
+    const Clock::time_point start = timing.starts.back();
+    timing.starts.pop_back();
+    if (traceEnabled && start != Clock::time_point())
+      timing.events.push_back({label, start, Clock::now()});
+  }
 #endif
 }
 
 } // namespace internal
+
+/* ************************************************************************* */
+void tictoc_writeChromeTrace_(const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  if (!os)
+    throw std::runtime_error(
+        "tictoc_writeChromeTrace: cannot open " + filename + " for writing");
+  internal::writeChromeTrace(os);
+}
+
 } // namespace gtsam
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <cstddef>
+#include <iosfwd>
 #include <string>
 
 // This file contains the GTSAM timing instrumentation library, a low-overhead method for
@@ -106,6 +107,21 @@
 //   too scope.  Note that if you use these, it may become difficult to ensure that you
 //   have matching gttic/gttoc statments.  You may want to consider reorganizing your timing
 //   outline to match the scope of your code.
+//
+// Multi-threaded timing:
+//
+// - Each thread records into its own timing outline, so gttic/gttoc may be used freely
+//   inside TBB tasks.  The outline of the main thread is gTimingRoot; tictoc_print_ and
+//   tictoc_print2_ merge the outlines of all other threads into it before printing.  A
+//   worker thread's top-level labels are placed under the first node in the main outline
+//   with the same label (the main thread usually participates in the parallel loop), and
+//   under the root otherwise.
+//
+// - Calling tictoc_enableTrace_(true) additionally records every timed interval with its
+//   start time and thread.  tictoc_writeChromeTrace_("trace.json") writes these events in
+//   the Chrome trace-event format, which can be loaded in chrome://tracing or Perfetto.
+//
+// - Printing, resetting and writing traces must not run concurrently with timed code.
 
 #ifdef GTSAM_USE_BOOST_FEATURES
 // Automatically use the new Boost timers if version is recent enough.
@@ -205,7 +221,19 @@ namespace gtsam {
       GTSAM_EXPORT void toc();
       GTSAM_EXPORT void finishedIteration();
 
+      /// Deep copy of this subtree, without parent
+      GTSAM_EXPORT std::shared_ptr<TimingOutline> cloneTree() const;
+      /// Add the statistics of \c other, and recursively of its children, to this subtree
+      GTSAM_EXPORT void merge(const TimingOutline& other, const std::weak_ptr<TimingOutline>& thisPtr);
+      /// Find the first node in this subtree (pre-order) with the given ID, or nullptr
+      GTSAM_EXPORT TimingOutline* find(size_t id);
+
+      size_t id() const { return id_; } ///< ID of this node's label
+      const std::string& label() const { return label_; } ///< label of this node
+      size_t n() const { return n_; } ///< number of times this node was timed
+
       GTSAM_EXPORT friend void toc(size_t id, const char *label);
+      GTSAM_EXPORT friend std::shared_ptr<TimingOutline> mergedTimingRoot();
     }; // \TimingOutline
 
     /**
@@ -233,6 +261,24 @@ namespace gtsam {
 
     GTSAM_EXTERN_EXPORT std::shared_ptr<TimingOutline> gTimingRoot;
     GTSAM_EXTERN_EXPORT std::weak_ptr<TimingOutline> gCurrentTimer;
+
+    // Current timer of the calling thread (gCurrentTimer on the main thread)
+    GTSAM_EXPORT std::weak_ptr<TimingOutline>& currentTimer();
+
+    // Copy of gTimingRoot with the outlines of all other threads merged in
+    GTSAM_EXPORT std::shared_ptr<TimingOutline> mergedTimingRoot();
+
+    // Finish the iteration on the outlines of all threads
+    GTSAM_EXPORT void finishedIteration();
+
+    // Clear the outlines and recorded trace events of all threads
+    GTSAM_EXPORT void resetTiming();
+
+    // Enable or disable recording of trace events
+    GTSAM_EXPORT void setTraceEnabled(bool enabled);
+
+    // Write recorded trace events in Chrome trace-event JSON format
+    GTSAM_EXPORT void writeChromeTrace(std::ostream& os);
   }
 
 // Tic and toc functions that are always active (whether or not ENABLE_TIMING is defined)
@@ -262,26 +308,32 @@ namespace gtsam {
 
 // indicate iteration is finished
 inline void tictoc_finishedIteration_() {
-  ::gtsam::internal::gTimingRoot->finishedIteration(); }
+  ::gtsam::internal::finishedIteration(); }
 
 // print
 inline void tictoc_print_() {
-  ::gtsam::internal::gTimingRoot->print(); }
+  ::gtsam::internal::mergedTimingRoot()->print(); }
 
 // print mean and standard deviation
 inline void tictoc_print2_() {
-  ::gtsam::internal::gTimingRoot->print2(); }
+  ::gtsam::internal::mergedTimingRoot()->print2(); }
 
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
   const std::shared_ptr<const ::gtsam::internal::TimingOutline> variable = \
-  ::gtsam::internal::gCurrentTimer.lock()->child(label##_id_getnode, #label, ::gtsam::internal::gCurrentTimer);
+  ::gtsam::internal::currentTimer().lock()->child(label##_id_getnode, #label, ::gtsam::internal::currentTimer());
 
 // reset
 inline void tictoc_reset_() {
-  ::gtsam::internal::gTimingRoot.reset(new ::gtsam::internal::TimingOutline("Total", ::gtsam::internal::getTicTocID("Total")));
-  ::gtsam::internal::gCurrentTimer = ::gtsam::internal::gTimingRoot; }
+  ::gtsam::internal::resetTiming(); }
+
+// start or stop recording trace events
+inline void tictoc_enableTrace_(bool enabled = true) {
+  ::gtsam::internal::setTraceEnabled(enabled); }
+
+// write recorded trace events as Chrome/Perfetto trace-event JSON
+GTSAM_EXPORT void tictoc_writeChromeTrace_(const std::string& filename);
 
 #ifdef ENABLE_TIMING
 #define gttic(label) gttic_(label)
@@ -291,6 +343,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration tictoc_finishedIteration_
 #define tictoc_print tictoc_print_
 #define tictoc_reset tictoc_reset_
+#define tictoc_enableTrace tictoc_enableTrace_
+#define tictoc_writeChromeTrace tictoc_writeChromeTrace_
 #else
 #define gttic(label) ((void)0)
 #define gttoc(label) ((void)0)
@@ -299,6 +353,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration() ((void)0)
 #define tictoc_print() ((void)0)
 #define tictoc_reset() ((void)0)
+#define tictoc_enableTrace(...) ((void)0)
+#define tictoc_writeChromeTrace(filename) ((void)0)
 #endif
 
 }
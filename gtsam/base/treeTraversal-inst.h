@@ -28,6 +28,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <cassert>
 
 namespace gtsam {
@@ -159,12 +160,72 @@ void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
   typedef typename FOREST::Node Node;
 
   internal::CreateRootTask<Node>(forest.roots(), rootData, visitorPre,
-      visitorPost, problemSizeThreshold);
+      visitorPost, internal::ProblemSizeScheduler{problemSizeThreshold});
 #else
   DepthFirstForest(forest, rootData, visitorPre, visitorPost);
 #endif
 }
 
+/** Traverse a forest depth-first with pre-order and post-order visits, in parallel, creating
+ *  tasks by work estimate.  A subtree is visited in a task of its own if its estimated work
+ *  \c subtreeWork(node) is at least \c minTaskWork, smaller subtrees are visited in the task of
+ *  their parent, which avoids creating tasks that cost more than the work they do.  The
+ *  visitors are as in DepthFirstForestParallel above.
+ *  @param subtreeWork Function object taking a \c const \c FOREST::Node& and returning the
+ *         estimated work of eliminating the subtree rooted at that node, it is called
+ *         concurrently. */
+template<class FOREST, typename DATA, typename VISITOR_PRE,
+    typename VISITOR_POST, typename SUBTREE_WORK>
+void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
+    VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+    const SUBTREE_WORK& subtreeWork, double minTaskWork) {
+#ifdef GTSAM_USE_TBB
+  // Typedefs
+  typedef typename FOREST::Node Node;
+
+  internal::CreateRootTask<Node>(forest.roots(), rootData, visitorPre,
+      visitorPost, internal::WorkScheduler<SUBTREE_WORK>{subtreeWork, minTaskWork});
+#else
+  DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+#endif
+}
+
+/** Estimated work of every subtree of a forest, as the \c subtreeWork argument of the
+ *  work-based DepthFirstForestParallel.  It is computed once, serially, and can then be read
+ *  concurrently. */
+template<class NODE>
+class SubtreeWork {
+  std::unordered_map<const NODE*, double> work_;
+  double total_ = 0.0;
+
+  struct Data {
+    double* parentWork;
+    double work;
+  };
+
+ public:
+  /** @param nodeWork Function object taking a \c const \c NODE& and returning the estimated
+   *         work of visiting that node alone. */
+  template<class FOREST, class NODE_WORK>
+  SubtreeWork(const FOREST& forest, const NODE_WORK& nodeWork) {
+    Data rootData{&total_, 0.0};
+    auto visitorPre = [&nodeWork](const std::shared_ptr<NODE>& node, Data& parentData) {
+      return Data{&parentData.work, nodeWork(*node)};
+    };
+    auto visitorPost = [this](const std::shared_ptr<NODE>& node, const Data& data) {
+      work_.emplace(node.get(), data.work);
+      *data.parentWork += data.work;
+    };
+    DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+  }
+
+  /// Estimated work of the subtree rooted at \c node
+  double operator()(const NODE& node) const { return work_.at(&node); }
+
+  /// Estimated work of the whole forest
+  double total() const { return total_; }
+};
+
 /* ************************************************************************* */
 /** Traversal function for CloneForest */
 namespace {
@@ -19,6 +19,8 @@
 #include <gtsam/global_includes.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #ifdef GTSAM_USE_TBB
 #include <tbb/task_group.h>         // tbb::task_group
@@ -32,7 +34,31 @@ namespace gtsam {
     namespace internal {
 
       /* ************************************************************************* */
-      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
+      /// Task creation by problem size: every child of a node gets a task, and these tasks may
+      /// create further tasks if the problem size of the node is at least the threshold.
+      struct ProblemSizeScheduler
+      {
+        int problemSizeThreshold;
+        template<typename NODE> bool spawn(const NODE&) const { return true; }
+        template<typename NODE> bool makeNewTasks(const NODE& node) const {
+          return node.problemSize() >= problemSizeThreshold; }
+      };
+
+      /// Task creation by work estimate: a child gets a task if the estimated work of its
+      /// subtree is at least \c minTaskWork, otherwise it is visited in the task of its parent.
+      template<typename SUBTREE_WORK>
+      struct WorkScheduler
+      {
+        const SUBTREE_WORK& subtreeWork;
+        double minTaskWork;
+        template<typename NODE> bool spawn(const NODE& node) const {
+          return subtreeWork(node) >= minTaskWork; }
+        template<typename NODE> bool makeNewTasks(const NODE&) const { return true; }
+      };
+
+      /* ************************************************************************* */
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST,
+               typename SCHEDULER>
       class PreOrderTask
       {
       public:
@@ -40,7 +66,7 @@ namespace gtsam {
         std::shared_ptr<DATA> myData;
         VISITOR_PRE& visitorPre;
         VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
+        const SCHEDULER& scheduler;
         tbb::task_group& tg;
         bool makeNewTasks;
 
@@ -48,13 +74,13 @@ namespace gtsam {
         mutable bool isPostOrderPhase;
 
         PreOrderTask(const std::shared_ptr<NODE>& treeNode, const std::shared_ptr<DATA>& myData,
-                     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold,
-                     tbb::task_group& tg, bool makeNewTasks = true)
+                     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                     const SCHEDULER& scheduler, tbb::task_group& tg, bool makeNewTasks = true)
             : treeNode(treeNode),
               myData(myData),
               visitorPre(visitorPre),
               visitorPost(visitorPost),
-              problemSizeThreshold(problemSizeThreshold),
+              scheduler(scheduler),
               tg(tg),
               makeNewTasks(makeNewTasks),
               isPostOrderPhase(false) {}
@@ -72,10 +98,13 @@ namespace gtsam {
             {
               if(!treeNode->children.empty())
               {
-                bool overThreshold = (treeNode->problemSize() >= problemSizeThreshold);
+                bool childrenMakeNewTasks = scheduler.makeNewTasks(*treeNode);
 
-                // If we have child tasks, start subtasks and wait for them to complete
+                // If we have child tasks, start subtasks and wait for them to complete.  Children
+                // that are not worth a task of their own are visited in this task meanwhile.
                 tbb::task_group ctg;
+                std::vector<std::pair<const std::shared_ptr<NODE>*, std::shared_ptr<DATA> > >
+                    inlineChildren;
                 for(const std::shared_ptr<NODE>& child: treeNode->children)
                 {
                   // Process child in a subtask.  Important:  Run visitorPre before calling
@@ -83,8 +112,23 @@ namespace gtsam {
                   // allocated an extra child, this causes a TBB error.
                   std::shared_ptr<DATA> childData = std::allocate_shared<DATA>(
                       tbb::scalable_allocator<DATA>(), visitorPre(child, *myData));
-                  ctg.run(PreOrderTask(child, childData, visitorPre, visitorPost,
-                      problemSizeThreshold, ctg, overThreshold));
+                  if(scheduler.spawn(*child))
+                    ctg.run(PreOrderTask(child, childData, visitorPre, visitorPost,
+                        scheduler, ctg, childrenMakeNewTasks));
+                  else
+                    inlineChildren.emplace_back(&child, childData);
+                }
+                try
+                {
+                  for(const auto& [child, childData]: inlineChildren)
+                    processNodeRecursively(*child, *childData);
+                }
+                catch(...)
+                {
+                  // Do not leave the subtasks running, report the first exception
+                  ctg.cancel();
+                  try { ctg.wait(); } catch(...) {}
+                  throw;
                 }
                 ctg.wait();
 
@@ -120,7 +164,8 @@ namespace gtsam {
       };
 
       /* ************************************************************************* */
-      template<typename ROOTS, typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
+      template<typename ROOTS, typename NODE, typename DATA, typename VISITOR_PRE,
+               typename VISITOR_POST, typename SCHEDULER>
       class RootTask
       {
       public:
@@ -128,31 +173,36 @@ namespace gtsam {
         DATA& myData;
         VISITOR_PRE& visitorPre;
         VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
+        const SCHEDULER& scheduler;
         tbb::task_group& tg;
         RootTask(const ROOTS& roots, DATA& myData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-          int problemSizeThreshold, tbb::task_group& tg) :
+          const SCHEDULER& scheduler, tbb::task_group& tg) :
           roots(roots), myData(myData), visitorPre(visitorPre), visitorPost(visitorPost),
-          problemSizeThreshold(problemSizeThreshold), tg(tg) {}
+          scheduler(scheduler), tg(tg) {}
 
         void operator()() const
         {
-          typedef PreOrderTask<NODE, DATA, VISITOR_PRE, VISITOR_POST> PreOrderTask;
-          // Create data and tasks for our children
+          typedef PreOrderTask<NODE, DATA, VISITOR_PRE, VISITOR_POST, SCHEDULER> PreOrderTask;
+          // Create data and tasks for our children, small trees are visited in this task
           for(const std::shared_ptr<NODE>& root: roots)
           {
             std::shared_ptr<DATA> rootData = std::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(root, myData));
-            tg.run(PreOrderTask(root, rootData, visitorPre, visitorPost, problemSizeThreshold, tg));
+            if(scheduler.spawn(*root))
+              tg.run(PreOrderTask(root, rootData, visitorPre, visitorPost, scheduler, tg));
+            else
+              PreOrderTask(root, rootData, visitorPre, visitorPost, scheduler, tg, false)();
           }
         }
       };
 
-      template<typename NODE, typename ROOTS, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
-      void CreateRootTask(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold)
+      template<typename NODE, typename ROOTS, typename DATA, typename VISITOR_PRE, typename VISITOR_POST,
+               typename SCHEDULER>
+      void CreateRootTask(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                          const SCHEDULER& scheduler)
       {
-          typedef RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST> RootTask;
+          typedef RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST, SCHEDULER> RootTask;
           tbb::task_group tg;
-          tg.run_and_wait(RootTask(roots, rootData, visitorPre, visitorPost, problemSizeThreshold, tg));
+          tg.run_and_wait(RootTask(roots, rootData, visitorPre, visitorPost, scheduler, tg));
       }
 
     }
@@ -16,9 +16,11 @@
 #include <gtsam/base/treeTraversal-inst.h>
 
 #ifdef GTSAM_USE_TBB
-#include <mutex>
+#include <tbb/task_arena.h>
 #endif
+#include <algorithm>
 #include <queue>
+#include <unordered_map>
 
 namespace gtsam {
 
@@ -143,6 +145,13 @@ ClusterTree<GRAPH>& ClusterTree<GRAPH>::operator=(const This& other) {
   return *this;
 }
 
+/* ************************************************************************* */
+namespace internal {
+/// Subtrees with less estimated work than this (in variable blocks, see
+/// Cluster::eliminationWork) are not worth a task of their own
+static const double kMinTaskWork = 1000.0;
+}  // namespace internal
+
 /* ************************************************************************* */
 // Elimination traversal data - stores a pointer to the parent data and collects
 // the factors resulting from elimination of the children.  Also sets up BayesTree
@@ -160,25 +169,16 @@ struct EliminationData {
   size_t myIndexInParent;
   FastVector<sharedFactor> childFactors;
   std::shared_ptr<BTNode> bayesTreeNode;
-#ifdef GTSAM_USE_TBB
-  std::shared_ptr<std::mutex> writeLock;
-#endif
 
   EliminationData(EliminationData* _parentData, size_t nChildren) :
-      parentData(_parentData), bayesTreeNode(std::make_shared<BTNode>())
-#ifdef GTSAM_USE_TBB
-      , writeLock(std::make_shared<std::mutex>())
-#endif
-    {
+      parentData(_parentData), bayesTreeNode(std::make_shared<BTNode>()) {
+    // Every child writes its remaining factor into its own, pre-assigned slot, so that
+    // concurrent children do not need a lock.
+    childFactors.resize(nChildren);
     if (parentData) {
-#ifdef GTSAM_USE_TBB
-      parentData->writeLock->lock();
-#endif
-      myIndexInParent = parentData->childFactors.size();
-      parentData->childFactors.push_back(sharedFactor());
-#ifdef GTSAM_USE_TBB
-      parentData->writeLock->unlock();
-#endif
+      // Children are created one at a time by the task of their parent
+      myIndexInParent = parentData->bayesTreeNode->children.size();
+      assert(myIndexInParent < parentData->childFactors.size());
     } else {
       myIndexInParent = 0;
     }
@@ -253,15 +253,8 @@ struct EliminationData {
 #endif
       }
       // Store remaining factor in parent's gathered factors
-      if (!eliminationResult.second->empty()) {
-#ifdef GTSAM_USE_TBB
-        myData.parentData->writeLock->lock();
-#endif
+      if (!eliminationResult.second->empty())
         myData.parentData->childFactors[myData.myIndexInParent] = eliminationResult.second;
-#ifdef GTSAM_USE_TBB
-        myData.parentData->writeLock->unlock();
-#endif
-      }
     }
   };
 };
@@ -295,8 +288,21 @@ EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function)
   typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_);
   {
     TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
+#ifdef GTSAM_USE_TBB
+    // Create tasks by estimated work: aim for several tasks per thread, but never for tasks
+    // smaller than the overhead of creating them.
+    typedef typename This::Node Node;
+    const treeTraversal::SubtreeWork<Node> subtreeWork(
+        *this, [](const Node& node) { return node.eliminationWork(); });
+    const double minTaskWork =
+        std::max(internal::kMinTaskWork,
+                 subtreeWork.total() / (4.0 * tbb::this_task_arena::max_concurrency()));
     treeTraversal::DepthFirstForestParallel(*this, rootsContainer, Data::EliminationPreOrderVisitor,
-                                            visitorPost, 10);
+                                            visitorPost, subtreeWork, minTaskWork);
+#else
+    treeTraversal::DepthFirstForest(*this, rootsContainer, Data::EliminationPreOrderVisitor,
+                                    visitorPost);
+#endif
   }
 
   // Create BayesTree from roots stored in the dummy BayesTree node.
@@ -44,7 +44,10 @@ class ClusterTree {
 
     int problemSize_;
 
-    Cluster() : problemSize_(0) {}
+    /// Number of separator keys of the eliminated clique, if known (set by JunctionTree)
+    size_t nrSeparatorKeys_;
+
+    Cluster() : problemSize_(0), nrSeparatorKeys_(0) {}
 
     virtual ~Cluster() {}
 
@@ -55,7 +58,7 @@ class ClusterTree {
     /// Construct from factors associated with a single key
     template <class CONTAINER>
     Cluster(Key key, const CONTAINER& factorsToAdd)
-        : problemSize_(0) {
+        : problemSize_(0), nrSeparatorKeys_(0) {
       addFactors(key, factorsToAdd);
     }
 
@@ -89,6 +92,16 @@ class ClusterTree {
       return problemSize_;
     }
 
+    /**
+     * Estimated work of eliminating this cluster alone, counted in variable blocks: a dense
+     * partial factorization of f frontal and s separator variables costs about
+     * \f$ f^3/3 + f^2 s + f s^2 \f$ block operations.
+     */
+    double eliminationWork() const {
+      const double f = nrFrontals(), s = nrSeparatorKeys_;
+      return f * (f * f / 3.0 + f * s + s * s);
+    }
+
     /// print this node
     virtual void print(const std::string& s = "",
                        const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
@@ -97,7 +97,7 @@ namespace gtsam {
       for (size_t j = 0; j < n; j++)
       {
         // Retrieve the factors involving this variable and create the current node
-        const FactorIndices& factors = structure[order[j]];
+        const VariableIndex::Factors factors = structure[order[j]];
         const sharedNode node = std::make_shared<Node>();
         node->key = order[j];
 
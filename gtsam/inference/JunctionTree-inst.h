@@ -33,16 +33,20 @@ struct ConstructorTraversalData {
   typedef typename JunctionTree<BAYESTREE, GRAPH>::sharedNode sharedNode;
 
   ConstructorTraversalData* const parentData;
+  const AmalgamationParams* amalgamation;
   sharedNode junctionTreeNode;
   FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
   FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
+  // Structural nonzero blocks in the conditionals of the child cliques
+  FastVector<size_t> childNonzeros;
 
   // Small inner class to store symbolic factors
   class SymbolicFactors: public FactorGraph<Factor> {
   };
 
-  ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+  ConstructorTraversalData(ConstructorTraversalData* _parentData,
+                           const AmalgamationParams* _amalgamation) :
+      parentData(_parentData), amalgamation(_amalgamation) {
   }
 
   // Pre-order visitor function
@@ -52,7 +56,8 @@ struct ConstructorTraversalData {
     // On the pre-order pass, before children have been visited, we just set up
     // a traversal data structure with its own JT node, and create a child
     // pointer in its parent.
-    ConstructorTraversalData myData = ConstructorTraversalData(&parentData);
+    ConstructorTraversalData myData =
+        ConstructorTraversalData(&parentData, parentData.amalgamation);
     myData.junctionTreeNode =
         std::make_shared<Node>(node->key, node->factors);
     parentData.junctionTreeNode->addChild(myData.junctionTreeNode);
@@ -94,28 +99,46 @@ struct ConstructorTraversalData {
     const FastVector<SymbolicConditional::shared_ptr>& childConditionals =
         myData.childSymbolicConditionals;
     node->problemSize_ = (int) (myConditional->size() * symbolicFactors.size());
+    // Our separator is the separator of the whole clique, whatever gets merged
+    node->nrSeparatorKeys_ = myConditional->nrParents();
 
     // Merge our children if they are in our clique - if our conditional has
     // exactly one fewer parent than our child's conditional.
     const size_t myNrParents = myConditional->nrParents();
     const size_t nrChildren = node->nrChildren();
     assert(childConditionals.size() == nrChildren);
+    assert(myData.childNonzeros.size() == nrChildren);
 
     // decide which children to merge, as index into children
     std::vector<size_t> nrFrontals = node->nrFrontalsOfChildren();
     std::vector<bool> merge(nrChildren, false);
     size_t myNrFrontals = 1;
+    size_t myNonzeros = 1 + myNrParents;
+    const AmalgamationParams& amalgamation = *myData.amalgamation;
     for (size_t i = 0;i<nrChildren;i++){
       // Check if we should merge the i^th child
       if (myNrParents + myNrFrontals == childConditionals[i]->nrParents()) {
+        merge[i] = true;
+      } else if (amalgamation.relaxed() &&
+                 myNrFrontals + nrFrontals[i] <= amalgamation.maxFrontals) {
+        // The child's separator is part of our clique, so the merged clique
+        // keeps our separator.  Its conditional stores a dense block upper-
+        // triangular matrix, count how many of those blocks would be zero.
+        const size_t n = myNrFrontals + nrFrontals[i];
+        const size_t stored = n * (n + 1) / 2 + n * myNrParents;
+        const size_t zeros = stored - (myNonzeros + myData.childNonzeros[i]);
+        merge[i] = zeros <= amalgamation.maxZeroFraction * stored;
+      }
+      if (merge[i]) {
         // Increment number of frontal variables
         myNrFrontals += nrFrontals[i];
-        merge[i] = true;
+        myNonzeros += myData.childNonzeros[i];
       }
     }
 
     // now really merge
     node->mergeChildren(merge);
+    myData.parentData->childNonzeros.push_back(myNonzeros);
   }
 };
 
@@ -123,20 +146,22 @@ struct ConstructorTraversalData {
 template<class BAYESTREE, class GRAPH>
 template<class ETREE_BAYESNET, class ETREE_GRAPH>
 JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
-    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) {
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    const AmalgamationParams& amalgamation) {
   gttic(JunctionTree_FromEliminationTree);
   // Here we rely on the BayesNet having been produced by this elimination tree,
   // such that the conditionals are arranged in DFS post-order.  We traverse the
   // elimination tree, and inspect the symbolic conditional corresponding to
   // each node.  The elimination tree node is added to the same clique with its
   // parent if it has exactly one more Bayes net conditional parent than
-  // does its elimination tree parent.
+  // does its elimination tree parent, or, with relaxed amalgamation, if the
+  // merged clique does not store too many zeros.
 
   // Traverse the elimination tree, doing symbolic elimination and merging nodes
   // as we go.  Gather the created junction tree roots in a dummy Node.
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
-  Data rootData(0);
+  Data rootData(0, &amalgamation);
   // Make a dummy node to gather the junction tree roots
   rootData.junctionTreeNode = std::make_shared<typename Base::Node>();
   treeTraversal::DepthFirstForest(eliminationTree, rootData,
@@ -27,6 +27,30 @@ namespace gtsam {
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
 
+  /**
+   * Parameters of relaxed supernode amalgamation in JunctionTree construction.  By default a
+   * clique is only merged with its parent when that does not change the structure of the
+   * eliminated conditional.  Relaxed amalgamation also merges a clique when the conditional of
+   * the merged clique stores few explicit zero blocks, giving fewer and larger dense fronts,
+   * which is cheaper when cliques are tiny, as in pose chains.  The Bayes tree stays exact, its
+   * conditionals just contain some zero blocks.
+   */
+  struct AmalgamationParams {
+    /// Maximum fraction of zero blocks in the block upper-triangular conditional of a merged
+    /// clique.  0 (the default) only merges cliques with identical structure.
+    double maxZeroFraction = 0.0;
+
+    /// Relaxed amalgamation does not grow a clique beyond this many frontal variables
+    size_t maxFrontals = 32;
+
+    AmalgamationParams() {}
+    AmalgamationParams(double maxZeroFraction, size_t maxFrontals = 32)
+        : maxZeroFraction(maxZeroFraction), maxFrontals(maxFrontals) {}
+
+    /// Whether relaxed amalgamation is enabled
+    bool relaxed() const { return maxZeroFraction > 0.0; }
+  };
+
   /**
    * A JunctionTree is a cluster tree, a set of variable clusters with factors, arranged in a tree,
    * with the additional property that it represents the clique tree associated with a Bayes Net.
@@ -64,9 +88,11 @@ namespace gtsam {
     template<class ETREE>
       static This FromEliminationTree(const ETREE& eliminationTree) { return This(eliminationTree); }
 
-    /** Build the junction tree from an elimination tree. */
+    /** Build the junction tree from an elimination tree, optionally with relaxed supernode
+     *  amalgamation. */
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
-    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+                 const AmalgamationParams& amalgamation = AmalgamationParams());
 
     /// @}
 
@@ -59,7 +59,7 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
 
   if (nVars == 1)
   {
-    return Ordering(KeyVector(1, variableIndex.begin()->first));
+    return Ordering(KeyVector(1, (*variableIndex.begin()).first));
   }
 
   const size_t nEntries = variableIndex.nEntries(), nFactors =
@@ -76,11 +76,10 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   KeyVector keys(nVars); // Array to store the keys in the order we add them so we can retrieve them in permuted order
   size_t index = 0;
   for (auto key_factors: variableIndex) {
-    // Arrange factor indices into COLAMD format
-    const FactorIndices& column = key_factors.second;
-    for(size_t factorIndex: column) {
-      A[count++] = (int) factorIndex; // copy sparse column
-    }
+    // Rows of the VariableIndex are already COLAMD's sparse columns
+    const VariableIndex::Factors column = key_factors.second;
+    std::copy(column.begin(), column.end(), A.begin() + count);
+    count += column.size();
     p[index + 1] = count;  // column j (base 1) goes from A[j-1] to A[j]-1
     // Store key in array and increment index
     keys[index] = key_factors.first;
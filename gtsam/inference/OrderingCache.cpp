@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OrderingCache.cpp
+ * @brief   Cache of elimination orderings keyed by the topology of a factor graph
+ */
+
+#include <gtsam/inference/OrderingCache.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void OrderingCache::Topology::addSlot(bool isFactor) {
+  // Combine the keys of the new slot into the running hash, as boost::hash_combine
+  size_t seed = prefixHashes_.back();
+  auto combine = [&seed](size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  combine(isFactor ? keys_.size() - offsets_.back() : size_t(-1));
+  for (size_t i = offsets_.back(); i < keys_.size(); ++i) combine(std::hash<Key>()(keys_[i]));
+  offsets_.push_back(keys_.size());
+  prefixHashes_.push_back(seed);
+}
+
+/* ************************************************************************* */
+bool OrderingCache::Topology::startsWith(const Topology& other) const {
+  const size_t n = other.size();
+  if (n > size() || prefixHashes_[n] != other.prefixHashes_[n]) return false;
+  return std::equal(other.offsets_.begin(), other.offsets_.end(), offsets_.begin()) &&
+         std::equal(other.keys_.begin(), other.keys_.end(), keys_.begin());
+}
+
+/* ************************************************************************* */
+KeyVector OrderingCache::Topology::keysFrom(size_t n) const {
+  return KeyVector(keys_.begin() + offsets_[n], keys_.end());
+}
+
+/* ************************************************************************* */
+Ordering OrderingCache::ordering(const Topology& topology, const FastMap<Key, int>& groups,
+                                 const std::function<Ordering()>& compute) {
+  for (auto entry = entries_.begin(); entry != entries_.end(); ++entry) {
+    if (!topology.startsWith(entry->topology)) continue;
+
+    if (entry->topology.size() == topology.size()) {
+      if (entry->groups != groups) continue;
+      // Same topology, move to the front
+      ++nrHits_;
+      entries_.splice(entries_.begin(), entries_, entry);
+      return entries_.front().ordering;
+    }
+
+    // The graph grew at the tail, the cached variables have to keep their groups
+    auto group = [](const FastMap<Key, int>& groups, Key key) {
+      auto it = groups.find(key);
+      return it == groups.end() ? 0 : it->second;
+    };
+    if (!std::all_of(entry->sortedKeys.begin(), entry->sortedKeys.end(), [&](Key key) {
+          return group(entry->groups, key) == group(groups, key);
+        }))
+      continue;
+
+    // Append the new variables, in order of appearance
+    gttic(OrderingCache_extend);
+    Ordering ordering = entry->ordering;
+    KeyVector sortedKeys = entry->sortedKeys;
+    for (Key key : topology.keysFrom(entry->topology.size())) {
+      auto it = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), key);
+      if (it == sortedKeys.end() || *it != key) {
+        sortedKeys.insert(it, key);
+        ordering.push_back(key);
+      }
+    }
+    const size_t nrGrown = entry->nrGrown + ordering.size() - entry->ordering.size();
+    if (nrGrown > maxGrowth_ * entry->ordering.size()) break;
+
+    // Variables keep their relative order within a constraint group
+    if (!groups.empty()) {
+      std::stable_sort(ordering.begin(), ordering.end(), [&](Key a, Key b) {
+        return group(groups, a) < group(groups, b);
+      });
+    }
+    ++nrHits_;
+    insert(topology, groups, ordering, nrGrown);
+    return ordering;
+  }
+
+  ++nrMisses_;
+  Ordering ordering = compute();
+  insert(topology, groups, ordering, 0);
+  return ordering;
+}
+
+/* ************************************************************************* */
+void OrderingCache::insert(const Topology& topology, const FastMap<Key, int>& groups,
+                           const Ordering& ordering, size_t nrGrown) {
+  if (capacity_ == 0) return;
+  KeyVector sortedKeys(ordering.begin(), ordering.end());
+  std::sort(sortedKeys.begin(), sortedKeys.end());
+  entries_.push_front(Entry{topology, groups, ordering, std::move(sortedKeys), nrGrown});
+  if (entries_.size() > capacity_) entries_.pop_back();
+}
+
+}  // namespace gtsam
@@ -0,0 +1,134 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OrderingCache.h
+ * @brief   Cache of elimination orderings keyed by the topology of a factor graph
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+
+#include <functional>
+#include <list>
+
+namespace gtsam {
+
+/**
+ * Caches fill-reducing orderings, keyed by the topology of a factor graph: the keys of every
+ * factor slot, together with the constraint groups the ordering was computed with (see
+ * Ordering::ColamdConstrained).
+ *
+ * Batch solvers often see the same topology again, e.g. when re-localizing against a map or
+ * re-running a fixed-lag window, or a topology that only grew at the tail.  In the first case
+ * the stored ordering is returned.  In the second case the stored ordering is extended with the
+ * new variables and re-sorted by constraint group, as long as the stored variables kept their
+ * constraint groups and the new variables are only a small fraction of the ordering; otherwise a
+ * fresh ordering is computed.
+ *
+ * Topologies are compared by hash first, and then exactly, so a hash collision never returns a
+ * wrong ordering.
+ */
+class GTSAM_EXPORT OrderingCache {
+ public:
+  /// Keys of every factor slot of a graph, with a hash of every prefix
+  class GTSAM_EXPORT Topology {
+   public:
+    /// Record the topology of \c graph
+    template <class FACTOR_GRAPH>
+    explicit Topology(const FACTOR_GRAPH& graph) {
+      offsets_.reserve(graph.size() + 1);
+      prefixHashes_.reserve(graph.size() + 1);
+      offsets_.push_back(0);
+      prefixHashes_.push_back(0);
+      for (const auto& factor : graph) {
+        if (factor) keys_.insert(keys_.end(), factor->begin(), factor->end());
+        addSlot(factor != nullptr);
+      }
+    }
+
+    /// Number of factor slots
+    size_t size() const { return offsets_.size() - 1; }
+
+    /// Hash of the first \c n factor slots
+    size_t hash(size_t n) const { return prefixHashes_[n]; }
+
+    /// Whether the first \c other.size() slots have the same keys as \c other
+    bool startsWith(const Topology& other) const;
+
+    /// Keys of the factors from slot \c n on, in slot order
+    KeyVector keysFrom(size_t n) const;
+
+   private:
+    void addSlot(bool isFactor);
+
+    KeyVector keys_;                    ///< keys of all factors, concatenated
+    FastVector<size_t> offsets_;        ///< start of each slot in keys_
+    FastVector<size_t> prefixHashes_;   ///< hash of the first i slots
+  };
+
+  /**
+   * @param capacity Number of topologies kept, the least recently used one is evicted.
+   * @param maxGrowth An ordering is extended for a grown graph only while the variables added
+   *        since it was computed are at most this fraction of it.
+   */
+  explicit OrderingCache(size_t capacity = 4, double maxGrowth = 0.2)
+      : capacity_(capacity), maxGrowth_(maxGrowth) {}
+
+  /**
+   * Ordering of a graph with topology \c topology, with variables in constraint group order.
+   * @param compute Computes a fresh ordering when nothing cached can be used.
+   */
+  Ordering ordering(const Topology& topology, const FastMap<Key, int>& groups,
+                    const std::function<Ordering()>& compute);
+
+  /// COLAMD ordering of \c graph, constrained by \c groups if given, computed only when needed
+  template <class FACTOR_GRAPH>
+  Ordering ordering(const FACTOR_GRAPH& graph,
+                    const FastMap<Key, int>& groups = FastMap<Key, int>()) {
+    return ordering(Topology(graph), groups, [&]() {
+      return groups.empty() ? Ordering::Colamd(graph)
+                            : Ordering::ColamdConstrained(graph, groups);
+    });
+  }
+
+  /// Number of topologies found in the cache, including grown ones
+  size_t nrHits() const { return nrHits_; }
+
+  /// Number of orderings that had to be computed
+  size_t nrMisses() const { return nrMisses_; }
+
+  /// Remove all cached orderings
+  void clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    Topology topology;
+    FastMap<Key, int> groups;
+    Ordering ordering;
+    KeyVector sortedKeys;   ///< keys of ordering, sorted for lookup
+    size_t nrGrown;         ///< keys appended since the ordering was computed
+  };
+
+  void insert(const Topology& topology, const FastMap<Key, int>& groups,
+              const Ordering& ordering, size_t nrGrown);
+
+  size_t capacity_;
+  double maxGrowth_;
+  std::list<Entry> entries_;  ///< most recently used first
+  size_t nrHits_ = 0;
+  size_t nrMisses_ = 0;
+};
+
+}  // namespace gtsam
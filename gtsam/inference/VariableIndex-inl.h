@@ -32,10 +32,8 @@ void VariableIndex::augment(const FG& factors, const FactorIndices* newFactorInd
     if (factors[i]) {
       const size_t globalI =
           newFactorIndices ? (*newFactorIndices)[i] : nFactors_;
-      for(const Key key: *factors[i]) {
-        index_[key].push_back(globalI);
-        ++nEntries_;
-      }
+      for(const Key key: *factors[i])
+        append(key, globalI);
     }
 
     // Increment factor count even if factors are null, to keep indices consistent
@@ -58,6 +56,11 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
   // indices need to remain consistent.  Removing factors from a factor graph
   // does not shift the indices of other factors.  Also, we keep nFactors_
   // one greater than the highest-numbered factor referenced in a VariableIndex.
+  //
+  // Entries are only marked as removed here, and every affected row is
+  // squeezed once at the end.  Rows live in map nodes, so the pointers stay
+  // valid.
+  std::vector<Row*> rows;
   ITERATOR factorIndex = firstFactor;
   size_t i = 0;
   for (; factorIndex != lastFactor; ++factorIndex, ++i) {
@@ -66,17 +69,15 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
           "Internal error, requested inconsistent number of factor indices and factors in VariableIndex::remove");
     if (factors[i]) {
       for(Key j: *factors[i]) {
-        FactorIndices& factorEntries = internalAt(j);
-        auto entry = std::find(factorEntries.begin(),
-            factorEntries.end(), *factorIndex);
-        if (entry == factorEntries.end())
-          throw std::invalid_argument(
-              "Internal error, indices and factors passed into VariableIndex::remove are not consistent with the existing variable index");
-        factorEntries.erase(entry);
-        --nEntries_;
+        Row& row = internalAt(j);
+        removeFromRow(row, *factorIndex);
+        rows.push_back(&row);
       }
     }
   }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  for (Row* row : rows) squeezeRow(*row);
 }
 
 /* ************************************************************************* */
@@ -84,9 +85,10 @@ template<typename ITERATOR>
 void VariableIndex::removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey) {
   for (ITERATOR key = firstKey; key != lastKey; ++key) {
     KeyMap::iterator entry = index_.find(*key);
-    if (!entry->second.empty())
+    if (entry->second.size != 0)
       throw std::invalid_argument(
           "Asking to remove variables from the variable index that are not unused");
+    nrHoles_ += entry->second.capacity;
     index_.erase(entry);
   }
 }
@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/timing.h>
 
 namespace gtsam {
 
@@ -26,14 +27,14 @@ using namespace std;
 /* ************************************************************************* */
 bool VariableIndex::equals(const VariableIndex& other, double tol) const {
   return this->nEntries_ == other.nEntries_ && this->nFactors_ == other.nFactors_
-    && this->index_ == other.index_;
+    && std::equal(begin(), end(), other.begin(), other.end());
 }
 
 /* ************************************************************************* */
 void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) const {
   cout << str;
   cout << "nEntries = " << nEntries() << ", nFactors = " << nFactors() << "\n";
-  for(KeyMap::value_type key_factors: index_) {
+  for(value_type key_factors: *this) {
     cout << "var " << keyFormatter(key_factors.first) << ":";
     for(const auto index: key_factors.second)
       cout << " " << index;
@@ -46,7 +47,7 @@ void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) c
 void VariableIndex::outputMetisFormat(ostream& os) const {
   os << size() << " " << nFactors() << "\n";
   // run over variables, which will be hyper-edges.
-  for(KeyMap::value_type key_factors: index_) {
+  for(value_type key_factors: *this) {
     // every variable is a hyper-edge covering its factors
     for(const auto index: key_factors.second)
       os << (index+1) << " "; // base 1
@@ -60,12 +61,71 @@ void VariableIndex::augmentExistingFactor(const FactorIndex factorIndex, const K
 {
   gttic(VariableIndex_augmentExistingFactor);
 
-  for(const Key key: newKeys) {
-    index_[key].push_back(factorIndex);
-    ++nEntries_;
-  }
+  for(const Key key: newKeys)
+    append(key, factorIndex);
 
   gttoc(VariableIndex_augmentExistingFactor);
 }
 
+/* ************************************************************************* */
+void VariableIndex::removeFromRow(Row& row, FactorIndex factorIndex) {
+  FactorIndex* first = entries_.data() + row.offset;
+  FactorIndex* last = first + row.size;
+  FactorIndex* entry = std::find(first, last, factorIndex);
+  if (entry == last)
+    throw std::invalid_argument(
+        "Internal error, indices and factors passed into VariableIndex::remove are not consistent with the existing variable index");
+  *entry = kRemovedEntry;
+  --nEntries_;
+}
+
+/* ************************************************************************* */
+void VariableIndex::squeezeRow(Row& row) {
+  // The freed entries become slack of the row
+  FactorIndex* first = entries_.data() + row.offset;
+  row.size = std::remove(first, first + row.size, kRemovedEntry) - first;
+}
+
+/* ************************************************************************* */
+void VariableIndex::grow(Row& row) {
+  // Reclaim the space left by moved and removed rows first, this also gives
+  // every row some slack
+  if (nrHoles_ > entries_.size() / 2) {
+    compact();
+    if (row.size < row.capacity) return;
+  }
+
+  const uint32_t capacity = std::max<uint32_t>(2 * row.capacity, 2);
+  if (row.capacity > 0 && row.offset + row.capacity == entries_.size()) {
+    // The last row grows in place
+    entries_.resize(row.offset + capacity);
+  } else {
+    const size_t offset = entries_.size();
+    entries_.resize(offset + capacity);
+    std::copy(entries_.begin() + row.offset,
+              entries_.begin() + row.offset + row.size,
+              entries_.begin() + offset);
+    nrHoles_ += row.capacity;
+    row.offset = offset;
+  }
+  row.capacity = capacity;
+}
+
+/* ************************************************************************* */
+void VariableIndex::compact() {
+  gttic(VariableIndex_compact);
+  FactorIndices entries;
+  entries.reserve(nEntries_ + nEntries_ / 4 + index_.size());
+  for (auto& [key, row] : index_) {
+    const size_t offset = entries.size();
+    entries.insert(entries.end(), entries_.begin() + row.offset,
+                   entries_.begin() + row.offset + row.size);
+    row.offset = offset;
+    row.capacity = row.size + row.size / 4 + 1;
+    entries.resize(offset + row.capacity);
+  }
+  entries_.swap(entries);
+  nrHoles_ = 0;
+}
+
 }
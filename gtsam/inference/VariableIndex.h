@@ -23,9 +23,17 @@
 #include <gtsam/base/FastVector.h>
 #include <gtsam/dllexport.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <stdexcept>
 #include <optional>
+#include <utility>
+
+#ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
+#include <boost/serialization/split_member.hpp>
+#endif
 
 namespace gtsam {
 
@@ -34,39 +42,119 @@ namespace gtsam {
  * factor graph.  The factor graph stores a collection of factors, each of
  * which involves a set of variables.  In contrast, the VariableIndex is built
  * from a factor graph prior to elimination, and stores the list of factors
- * that involve each variable.  This information is stored as a deque of
- * lists of factor indices.
+ * that involve each variable.
+ *
+ * The lists are stored compressed, as rows of one pooled array of factor
+ * indices.  Every row keeps some slack at its end, so appending a factor is
+ * amortized O(1) and does not allocate per variable.  A row that runs out of
+ * slack moves to the end of the pool.  Removing factors first only marks
+ * their entries, and then closes the gaps of every affected row in one pass,
+ * rather than shifting a row once per removed factor.  The space left behind
+ * by moved and removed rows is reclaimed in one pass when it exceeds half of
+ * the pool.
  * \nosubgrouping
  */
 class GTSAM_EXPORT VariableIndex {
  public:
   typedef std::shared_ptr<VariableIndex> shared_ptr;
-  typedef FactorIndices::iterator Factor_iterator;
-  typedef FactorIndices::const_iterator Factor_const_iterator;
+  typedef FactorIndex* Factor_iterator;
+  typedef const FactorIndex* Factor_const_iterator;
+
+  /**
+   * The factors involving one variable, a view into the VariableIndex that is
+   * valid until the VariableIndex is modified.
+   */
+  class Factors {
+   public:
+    typedef FactorIndex value_type;
+    typedef const FactorIndex* const_iterator;
+    typedef const FactorIndex* iterator;
+
+    Factors() : begin_(nullptr), end_(nullptr) {}
+    Factors(const FactorIndex* begin, const FactorIndex* end)
+        : begin_(begin), end_(end) {}
+
+    const_iterator begin() const { return begin_; }
+    const_iterator end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    FactorIndex operator[](size_t i) const { return begin_[i]; }
+    FactorIndex front() const { return *begin_; }
+    FactorIndex back() const { return *(end_ - 1); }
+
+    bool operator==(const Factors& other) const {
+      return std::equal(begin_, end_, other.begin_, other.end_);
+    }
+    bool operator!=(const Factors& other) const { return !(*this == other); }
+
+   private:
+    const FactorIndex* begin_;
+    const FactorIndex* end_;
+  };
 
  protected:
-  typedef FastMap<Key, FactorIndices> KeyMap;
+  /// A variable's factors, in entries_[offset, offset + size)
+  struct Row {
+    size_t offset = 0;
+    uint32_t size = 0;
+    uint32_t capacity = 0;
+  };
+
+  typedef FastMap<Key, Row> KeyMap;
   KeyMap index_;
+  FactorIndices entries_;  // Rows of all variables, each followed by its slack.
+  size_t nrHoles_;   // Entries not owned by any row, reclaimed by compact().
   size_t nFactors_;  // Number of factors in the original factor graph.
   size_t nEntries_;  // Sum of involved variable counts of each factor.
 
  public:
-  typedef KeyMap::const_iterator const_iterator;
-  typedef KeyMap::const_iterator iterator;
-  typedef KeyMap::value_type value_type;
+  /**
+   * Iterates over (variable, factors) pairs, in key order.  The pairs are
+   * returned by value, so there is no operator->: use (*it).second, or bind
+   * the pair to a variable before iterating over its factors.
+   */
+  class const_iterator {
+   public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef std::pair<Key, Factors> value_type;
+    typedef value_type reference;
+    typedef void pointer;
+    typedef std::ptrdiff_t difference_type;
+
+    const_iterator() : entries_(nullptr) {}
+    const_iterator(KeyMap::const_iterator it, const FactorIndex* entries)
+        : it_(it), entries_(entries) {}
+
+    value_type operator*() const {
+      const Row& row = it_->second;
+      return value_type(it_->first, Factors(entries_ + row.offset,
+                                            entries_ + row.offset + row.size));
+    }
+    const_iterator& operator++() { ++it_; return *this; }
+    const_iterator operator++(int) { const_iterator tmp = *this; ++it_; return tmp; }
+    bool operator==(const const_iterator& other) const { return it_ == other.it_; }
+    bool operator!=(const const_iterator& other) const { return it_ != other.it_; }
+
+   private:
+    KeyMap::const_iterator it_;
+    const FactorIndex* entries_;
+  };
+  typedef const_iterator iterator;
+  typedef const_iterator::value_type value_type;
 
   /// @name Standard Constructors
   /// @{
 
   /// Default constructor, creates an empty VariableIndex
-  VariableIndex() : nFactors_(0), nEntries_(0) {}
+  VariableIndex() : nrHoles_(0), nFactors_(0), nEntries_(0) {}
 
   /**
    * Create a VariableIndex that computes and stores the block column structure
    * of a factor graph.
    */
   template <class FG>
-  explicit VariableIndex(const FG& factorGraph) : nFactors_(0), nEntries_(0) {
+  explicit VariableIndex(const FG& factorGraph)
+      : nrHoles_(0), nFactors_(0), nEntries_(0) {
     augment(factorGraph);
   }
 
@@ -84,12 +172,12 @@ class GTSAM_EXPORT VariableIndex {
   size_t nEntries() const { return nEntries_; }
 
   /// Access a list of factors by variable
-  const FactorIndices& operator[](Key variable) const {
+  Factors operator[](Key variable) const {
     KeyMap::const_iterator item = index_.find(variable);
     if(item == index_.end())
       throw std::invalid_argument("Requested non-existent variable from VariableIndex");
     else
-    return item->second;
+      return factors(item->second);
   }
 
   /// Return true if no factors associated with a variable
@@ -160,45 +248,108 @@ class GTSAM_EXPORT VariableIndex {
   void removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey);
 
   /// Iterator to the first variable entry
-  const_iterator begin() const { return index_.begin(); }
+  const_iterator begin() const { return const_iterator(index_.begin(), entries_.data()); }
 
   /// Iterator to the first variable entry
-  const_iterator end() const { return index_.end(); }
+  const_iterator end() const { return const_iterator(index_.end(), entries_.data()); }
 
   /// Find the iterator for the requested variable entry
-  const_iterator find(Key key) const { return index_.find(key); }
+  const_iterator find(Key key) const { return const_iterator(index_.find(key), entries_.data()); }
+
+  /// Number of factor indices allocated, including the slack of every row
+  size_t capacity() const { return entries_.size() - nrHoles_; }
+
+  /// Bytes used by the factor index pool and the variable map
+  size_t memoryUsage() const {
+    return entries_.capacity() * sizeof(FactorIndex) + index_.size() * sizeof(KeyMap::value_type);
+  }
+
+  /// Move all rows to the front of the pool, keeping a little slack per row
+  void compact();
 
 protected:
-  Factor_iterator factorsBegin(Key variable) { return internalAt(variable).begin(); }
-  Factor_iterator factorsEnd(Key variable) { return internalAt(variable).end(); }
+  Factor_iterator factorsBegin(Key variable) { return entries_.data() + internalAt(variable).offset; }
+  Factor_iterator factorsEnd(Key variable) {
+    const Row& row = internalAt(variable);
+    return entries_.data() + row.offset + row.size;
+  }
 
-  Factor_const_iterator factorsBegin(Key variable) const { return internalAt(variable).begin(); }
-  Factor_const_iterator factorsEnd(Key variable) const { return internalAt(variable).end(); }
+  Factor_const_iterator factorsBegin(Key variable) const { return (*this)[variable].begin(); }
+  Factor_const_iterator factorsEnd(Key variable) const { return (*this)[variable].end(); }
 
   /// Internal version of 'at' that asserts existence
-  const FactorIndices& internalAt(Key variable) const {
+  const Row& internalAt(Key variable) const {
     const KeyMap::const_iterator item = index_.find(variable);
     assert(item != index_.end());
-    return item->second; 
+    return item->second;
   }
 
   /// Internal version of 'at' that asserts existence
-  FactorIndices& internalAt(Key variable) {
+  Row& internalAt(Key variable) {
     const KeyMap::iterator item = index_.find(variable);
     assert(item != index_.end());
-    return item->second; 
+    return item->second;
+  }
+
+  /// View of the factors in a row
+  Factors factors(const Row& row) const {
+    const FactorIndex* begin = entries_.data() + row.offset;
+    return Factors(begin, begin + row.size);
   }
 
+  /// Append a factor to the row of a variable, creating the row if needed
+  void append(Key variable, FactorIndex factorIndex) {
+    Row& row = index_[variable];
+    if (row.size == row.capacity) grow(row);
+    entries_[row.offset + row.size++] = factorIndex;
+    ++nEntries_;
+  }
+
+  /// Marks removed entries until their row is squeezed
+  static constexpr FactorIndex kRemovedEntry = FactorIndex(-1);
+
+  /// Mark the entry of one factor in a row as removed, see squeezeRow()
+  void removeFromRow(Row& row, FactorIndex factorIndex);
+
+  /// Close the gaps of removed entries in a row, keeping the order of the others
+  void squeezeRow(Row& row);
+
+  /// Double the capacity of a full row
+  void grow(Row& row);
+
 private:
 #ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
-  /** Serialization function */
+  /** Serialization function, the rows are stored as lists of factors */
   friend class boost::serialization::access;
   template<class ARCHIVE>
-  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
-    ar & BOOST_SERIALIZATION_NVP(index_);
+  void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+    FastMap<Key, FactorIndices> index;
+    for (const auto& [key, row] : index_) {
+      const Factors f = factors(row);
+      index.emplace(key, FactorIndices(f.begin(), f.end()));
+    }
+    ar & boost::serialization::make_nvp("index_", index);
+    ar & BOOST_SERIALIZATION_NVP(nFactors_);
+    ar & BOOST_SERIALIZATION_NVP(nEntries_);
+  }
+  template<class ARCHIVE>
+  void load(ARCHIVE & ar, const unsigned int /*version*/) {
+    FastMap<Key, FactorIndices> index;
+    ar & boost::serialization::make_nvp("index_", index);
+    index_.clear();
+    entries_.clear();
+    nrHoles_ = 0;
+    for (const auto& [key, factorIndices] : index) {
+      Row& row = index_[key];
+      for (const FactorIndex i : factorIndices) {
+        if (row.size == row.capacity) grow(row);
+        entries_[row.offset + row.size++] = i;
+      }
+    }
     ar & BOOST_SERIALIZATION_NVP(nFactors_);
     ar & BOOST_SERIALIZATION_NVP(nEntries_);
   }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
 #endif
 
   /// @}
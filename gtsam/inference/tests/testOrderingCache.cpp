@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testOrderingCache.cpp
+ * @brief   Unit tests for OrderingCache
+ */
+
+#include <gtsam/inference/OrderingCache.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+SymbolicFactorGraph chain(size_t n) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for (size_t i = 1; i < n; ++i) graph.push_factor(i - 1, i);
+  return graph;
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(OrderingCache, repeatedTopology) {
+  OrderingCache cache;
+  const SymbolicFactorGraph graph = chain(10);
+  const Ordering expected = Ordering::Colamd(graph);
+  EXPECT(assert_equal(expected, cache.ordering(graph)));
+  EXPECT_LONGS_EQUAL(0, cache.nrHits());
+  EXPECT_LONGS_EQUAL(1, cache.nrMisses());
+
+  // Same keys in the same slots, also when the graph is a copy
+  const SymbolicFactorGraph copy = chain(10);
+  EXPECT(assert_equal(expected, cache.ordering(copy)));
+  EXPECT_LONGS_EQUAL(1, cache.nrHits());
+
+  // Different constraint groups, or a different topology, need a new ordering
+  FastMap<Key, int> groups;
+  groups[0] = 1;
+  const Ordering constrained = cache.ordering(graph, groups);
+  EXPECT(assert_equal(Ordering::ColamdConstrained(graph, groups), constrained));
+  EXPECT_LONGS_EQUAL(0, constrained.back());
+  SymbolicFactorGraph other;
+  other.push_factor(5);
+  for (size_t i = 1; i < 10; ++i) other.push_factor(i - 1, i);
+  cache.ordering(other);
+  EXPECT_LONGS_EQUAL(1, cache.nrHits());
+  EXPECT_LONGS_EQUAL(3, cache.nrMisses());
+}
+
+/* ************************************************************************* */
+TEST(OrderingCache, grownTopology) {
+  OrderingCache cache(4, 0.2);
+  SymbolicFactorGraph graph = chain(10);
+  const Ordering base = cache.ordering(graph);
+
+  // Two new variables at the tail extend the cached ordering
+  graph.push_factor(9, 10);
+  graph.push_factor(10, 11);
+  Ordering expected = base;
+  expected.push_back(10);
+  expected.push_back(11);
+  EXPECT(assert_equal(expected, cache.ordering(graph)));
+  EXPECT_LONGS_EQUAL(1, cache.nrHits());
+
+  // The cached variables have to keep their constraint groups
+  graph.push_factor(11, 0);
+  FastMap<Key, int> groups;
+  groups[0] = 1;
+  groups[11] = 1;
+  EXPECT(assert_equal(Ordering::ColamdConstrained(graph, groups), cache.ordering(graph, groups)));
+  EXPECT_LONGS_EQUAL(1, cache.nrHits());
+  EXPECT_LONGS_EQUAL(2, cache.nrMisses());
+
+  // New variables are sorted into their constraint group
+  graph.push_factor(11, 12);
+  groups[12] = 0;
+  const Ordering constrained = cache.ordering(graph, groups);
+  EXPECT_LONGS_EQUAL(2, cache.nrHits());
+  EXPECT_LONGS_EQUAL(13, constrained.size());
+  EXPECT_LONGS_EQUAL(12, constrained[10]);
+  EXPECT(constrained[11] == 0 || constrained[12] == 0);
+  EXPECT(constrained[11] == 11 || constrained[12] == 11);
+
+  // Growing by more than 20% since the last full ordering computes a new one
+  for (size_t i = 13; i < 16; ++i) graph.push_factor(i - 1, i);
+  EXPECT(assert_equal(Ordering::ColamdConstrained(graph, groups), cache.ordering(graph, groups)));
+  EXPECT_LONGS_EQUAL(2, cache.nrHits());
+  EXPECT_LONGS_EQUAL(3, cache.nrMisses());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,191 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ContiguousVectorValues.cpp
+ * @brief Block vector stored in one contiguous buffer with a shared layout
+ */
+
+#include <gtsam/linear/ContiguousVectorValues.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ContiguousVectorValues::Layout::Layout(const VectorValues::Dims& dims) {
+  build(std::vector<std::pair<Key, size_t> >(dims.begin(), dims.end()));
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues::Layout::Layout(const VectorValues& values) {
+  std::vector<std::pair<Key, size_t> > dims;
+  dims.reserve(values.size());
+  for (const auto& key_value : values)
+    dims.emplace_back(key_value.first, key_value.second.size());
+  // VectorValues is unordered when built with TBB
+  sort(dims.begin(), dims.end());
+  build(std::move(dims));
+}
+
+/* ************************************************************************* */
+void ContiguousVectorValues::Layout::build(
+    std::vector<std::pair<Key, size_t> >&& dims) {
+  keys_.reserve(dims.size());
+  offsets_.reserve(dims.size() + 1);
+  offsets_.push_back(0);
+  for (const auto& key_dim : dims) {
+    keys_.push_back(key_dim.first);
+    offsets_.push_back(offsets_.back() + key_dim.second);
+  }
+}
+
+/* ************************************************************************* */
+size_t ContiguousVectorValues::Layout::find(Key j) const {
+  const auto it = lower_bound(keys_.begin(), keys_.end(), j);
+  if (it == keys_.end() || *it != j)
+    return keys_.size();
+  return it - keys_.begin();
+}
+
+/* ************************************************************************* */
+size_t ContiguousVectorValues::Layout::index(Key j) const {
+  const size_t i = find(j);
+  if (i == keys_.size())
+    throw out_of_range("Requested variable '" + DefaultKeyFormatter(j) +
+                       "' is not in this ContiguousVectorValues.");
+  return i;
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues::ContiguousVectorValues()
+    : layout_(std::make_shared<Layout>()) {}
+
+/* ************************************************************************* */
+ContiguousVectorValues::ContiguousVectorValues(
+    const Layout::shared_ptr& layout)
+    : layout_(layout), data_(Vector::Zero(layout->dim())) {}
+
+/* ************************************************************************* */
+ContiguousVectorValues::ContiguousVectorValues(
+    const Layout::shared_ptr& layout, const Vector& data)
+    : layout_(layout), data_(data) {
+  if (size_t(data_.size()) != layout_->dim())
+    throw invalid_argument(
+        "ContiguousVectorValues: the buffer size does not match the layout");
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues::ContiguousVectorValues(const VectorValues& values)
+    : ContiguousVectorValues(values, std::make_shared<Layout>(values)) {}
+
+/* ************************************************************************* */
+ContiguousVectorValues::ContiguousVectorValues(
+    const VectorValues& values, const Layout::shared_ptr& layout)
+    : layout_(layout), data_(layout->dim()) {
+  if (values.size() != layout_->size())
+    throw invalid_argument(
+        "ContiguousVectorValues: the VectorValues does not match the layout");
+  for (const auto& key_value : values) {
+    const size_t i = layout_->find(key_value.first);
+    if (i == layout_->size() ||
+        size_t(key_value.second.size()) != layout_->dim(i))
+      throw invalid_argument(
+          "ContiguousVectorValues: the VectorValues does not match the layout");
+    data_.segment(layout_->offset(i), layout_->dim(i)) = key_value.second;
+  }
+}
+
+/* ************************************************************************* */
+VectorValues ContiguousVectorValues::vectorValues() const {
+  VectorValues result;
+  for (size_t i = 0; i < layout_->size(); ++i)
+    result.emplace(layout_->keys()[i],
+                   data_.segment(layout_->offset(i), layout_->dim(i)));
+  return result;
+}
+
+/* ************************************************************************* */
+void ContiguousVectorValues::print(const string& str,
+                                   const KeyFormatter& formatter) const {
+  cout << str << ": " << size() << " elements\n";
+  for (size_t i = 0; i < layout_->size(); ++i)
+    cout << "  " << formatter(layout_->keys()[i]) << ": "
+         << data_.segment(layout_->offset(i), layout_->dim(i)).transpose()
+         << "\n";
+  cout.flush();
+}
+
+/* ************************************************************************* */
+bool ContiguousVectorValues::equals(const ContiguousVectorValues& x,
+                                    double tol) const {
+  if (layout_ != x.layout_ && !layout_->equals(*x.layout_))
+    return false;
+  return equal_with_abs_tol(data_, x.data_, tol);
+}
+
+/* ************************************************************************* */
+void ContiguousVectorValues::checkLayout(const ContiguousVectorValues& other,
+                                         const char* operation) const {
+  // Instances derived from each other share the layout pointer, so the full
+  // comparison is only needed for independently built layouts.
+  if (layout_ != other.layout_ && !layout_->equals(*other.layout_))
+    throw invalid_argument(string("ContiguousVectorValues::") + operation +
+                           " called with a vector of a different structure");
+}
+
+/* ************************************************************************* */
+double ContiguousVectorValues::dot(const ContiguousVectorValues& v) const {
+  checkLayout(v, "dot");
+  return data_.dot(v.data_);
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues ContiguousVectorValues::operator+(
+    const ContiguousVectorValues& c) const {
+  checkLayout(c, "operator+");
+  return ContiguousVectorValues(layout_, data_ + c.data_);
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues ContiguousVectorValues::operator-(
+    const ContiguousVectorValues& c) const {
+  checkLayout(c, "operator-");
+  return ContiguousVectorValues(layout_, data_ - c.data_);
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues& ContiguousVectorValues::operator+=(
+    const ContiguousVectorValues& c) {
+  checkLayout(c, "operator+=");
+  data_ += c.data_;
+  return *this;
+}
+
+/* ************************************************************************* */
+ContiguousVectorValues& ContiguousVectorValues::operator-=(
+    const ContiguousVectorValues& c) {
+  checkLayout(c, "operator-=");
+  data_ -= c.data_;
+  return *this;
+}
+
+/* ************************************************************************* */
+void ContiguousVectorValues::axpy(double a, const ContiguousVectorValues& x) {
+  checkLayout(x, "axpy");
+  data_ += a * x.data_;
+}
+
+}  // namespace gtsam
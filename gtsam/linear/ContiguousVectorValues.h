@@ -0,0 +1,233 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ContiguousVectorValues.h
+ * @brief Block vector stored in one contiguous buffer with a shared layout
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A block vector in which every variable's segment lives in a single aligned
+ * Eigen buffer, ordered by key.  The key to offset table is held in a Layout
+ * that is shared between all instances created from one another, so the
+ * BLAS-1 operations (dot, norm, axpy, +, -, scaling) are single vectorized
+ * loops over the buffer instead of per-key map traversals.
+ *
+ * This complements VectorValues, whose per-key storage supports insertion and
+ * returning \c Vector& references; convert to this class for the inner loops
+ * of iterative algorithms and back again with vectorValues().
+ */
+class GTSAM_EXPORT ContiguousVectorValues {
+ public:
+  /// Sorted keys with the offset and dimension of each block
+  class GTSAM_EXPORT Layout {
+   public:
+    typedef std::shared_ptr<const Layout> shared_ptr;
+
+    /// Empty layout
+    Layout() : offsets_(1, 0) {}
+
+    /// Layout of the given key dimensions
+    explicit Layout(const VectorValues::Dims& dims);
+
+    /// Layout with the same keys and dimensions as \c values
+    explicit Layout(const VectorValues& values);
+
+    /// Number of variables
+    size_t size() const { return keys_.size(); }
+
+    /// Total dimension
+    size_t dim() const { return offsets_.back(); }
+
+    /// Keys, in increasing order
+    const KeyVector& keys() const { return keys_; }
+
+    /// Offset of the i'th block in the buffer
+    size_t offset(size_t i) const { return offsets_[i]; }
+
+    /// Dimension of the i'th block
+    size_t dim(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+    /// Index of key \c j, or size() if it is not part of the layout
+    size_t find(Key j) const;
+
+    /// Index of key \c j, throws std::out_of_range if it is not present
+    size_t index(Key j) const;
+
+    /// Check whether two layouts have the same keys and dimensions
+    bool equals(const Layout& other) const {
+      return keys_ == other.keys_ && offsets_ == other.offsets_;
+    }
+
+   private:
+    void build(std::vector<std::pair<Key, size_t> >&& dims);
+
+    KeyVector keys_;
+    std::vector<size_t> offsets_;  ///< size() + 1 entries, last is dim()
+  };
+
+  typedef Eigen::VectorBlock<Vector> Segment;
+  typedef Eigen::VectorBlock<const Vector> ConstSegment;
+
+  /// @name Standard Constructors
+  /// @{
+
+  /// Empty vector
+  ContiguousVectorValues();
+
+  /// Zero vector with the given layout
+  explicit ContiguousVectorValues(const Layout::shared_ptr& layout);
+
+  /// Vector with the given layout and buffer contents
+  ContiguousVectorValues(const Layout::shared_ptr& layout, const Vector& data);
+
+  /// Copy of \c values, with a new layout
+  explicit ContiguousVectorValues(const VectorValues& values);
+
+  /**
+   * Copy of \c values into an existing layout, to share it with other
+   * instances.  Throws std::invalid_argument if the keys or dimensions differ.
+   */
+  ContiguousVectorValues(const VectorValues& values,
+                         const Layout::shared_ptr& layout);
+
+  /// Zero vector with the given layout
+  static ContiguousVectorValues Zero(const Layout::shared_ptr& layout) {
+    return ContiguousVectorValues(layout);
+  }
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /// Convert back to a VectorValues
+  VectorValues vectorValues() const;
+
+  /// The shared layout
+  const Layout::shared_ptr& layout() const { return layout_; }
+
+  /// Number of variables
+  size_t size() const { return layout_->size(); }
+
+  /// Total dimension
+  size_t dim() const { return layout_->dim(); }
+
+  /// Whether key \c j is part of the layout
+  bool exists(Key j) const { return layout_->find(j) < layout_->size(); }
+
+  /// The segment of key \c j, throws std::out_of_range if it is not present
+  Segment at(Key j) {
+    const size_t i = layout_->index(j);
+    return data_.segment(layout_->offset(i), layout_->dim(i));
+  }
+
+  /// The segment of key \c j, throws std::out_of_range if it is not present
+  ConstSegment at(Key j) const {
+    const size_t i = layout_->index(j);
+    return data_.segment(layout_->offset(i), layout_->dim(i));
+  }
+
+  /// Alias for at()
+  Segment operator[](Key j) { return at(j); }
+
+  /// Alias for at()
+  ConstSegment operator[](Key j) const { return at(j); }
+
+  /// The whole buffer, blocks in key order
+  const Vector& vector() const { return data_; }
+
+  /// The whole buffer, blocks in key order
+  Vector& vector() { return data_; }
+
+  /// Set all entries to zero
+  void setZero() { data_.setZero(); }
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /// print required by Testable
+  void print(const std::string& str = "ContiguousVectorValues",
+             const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+  /// equals required by Testable
+  bool equals(const ContiguousVectorValues& x, double tol = 1e-9) const;
+
+  /// @}
+  /// @name Linear algebra operations
+  /// @{
+
+  /// Dot product with a vector of the same layout
+  double dot(const ContiguousVectorValues& v) const;
+
+  /// Vector L2 norm
+  double norm() const { return data_.norm(); }
+
+  /// Squared vector L2 norm
+  double squaredNorm() const { return data_.squaredNorm(); }
+
+  /// Element-wise sum, requires the same layout
+  ContiguousVectorValues operator+(const ContiguousVectorValues& c) const;
+
+  /// Element-wise difference, requires the same layout
+  ContiguousVectorValues operator-(const ContiguousVectorValues& c) const;
+
+  /// In-place element-wise sum, requires the same layout
+  ContiguousVectorValues& operator+=(const ContiguousVectorValues& c);
+
+  /// In-place element-wise difference, requires the same layout
+  ContiguousVectorValues& operator-=(const ContiguousVectorValues& c);
+
+  /// Scaled copy
+  friend ContiguousVectorValues operator*(double a,
+                                          const ContiguousVectorValues& v) {
+    return ContiguousVectorValues(v.layout_, a * v.data_);
+  }
+
+  /// In-place scaling
+  ContiguousVectorValues& operator*=(double alpha) {
+    data_ *= alpha;
+    return *this;
+  }
+
+  /// In-place scaling, alias for operator*=
+  void scaleInPlace(double alpha) { data_ *= alpha; }
+
+  /// this += a * x, requires the same layout
+  void axpy(double a, const ContiguousVectorValues& x);
+
+  /// @}
+
+ private:
+  /// Throws std::invalid_argument unless \c other has the same layout
+  void checkLayout(const ContiguousVectorValues& other,
+                   const char* operation) const;
+
+  Layout::shared_ptr layout_;
+  Vector data_;
+};
+
+/// traits
+template <>
+struct traits<ContiguousVectorValues>
+    : public Testable<ContiguousVectorValues> {};
+
+}  // namespace gtsam
@@ -25,6 +25,10 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/VectorValues.h>
 
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
 namespace gtsam {
 
   // Instantiate base class
@@ -55,6 +59,97 @@ namespace gtsam {
     (*parentSum.logDet) += logDet;
     return parentSum;
   }
+
+  /* ************************************************************************ */
+  /**
+   * @brief Shared state of the top-down covariance recursion.
+   */
+  struct CovarianceRecursion {
+    typedef FastMap<const GaussianBayesTreeClique*, std::vector<std::pair<Key, Key> > > Requests;
+    const Requests* requests;                       ///< off-diagonal pairs assigned to cliques
+    GaussianBayesTree::CovarianceBlocks* result;
+    std::mutex* mutex;                              ///< guards result
+  };
+
+  /**
+   * @brief Joint covariance of the frontal and separator variables of a clique,
+   * passed to the child cliques in the pre-order visit.
+   */
+  struct CovarianceData {
+    const CovarianceRecursion* recursion;
+    Matrix joint;                                   ///< covariance of [frontals; separator]
+    FastMap<Key, std::pair<DenseIndex, DenseIndex> > blocks;  ///< offset and dim of each key
+    CovarianceData(const CovarianceRecursion* recursion) : recursion(recursion) {}
+
+    /// Extract the covariance between keys i and j
+    Matrix block(Key i, Key j) const {
+      const auto& bi = blocks.at(i);
+      const auto& bj = blocks.at(j);
+      return joint.block(bi.first, bj.first, bi.second, bj.second);
+    }
+  };
+
+  /* ************************************************************************ */
+  CovarianceData covarianceRecursion(const GaussianBayesTreeClique::shared_ptr& clique,
+                                     CovarianceData& parentData) {
+    const GaussianConditional& c = *clique->conditional();
+    Matrix R = c.R();
+    Matrix S = c.S();
+    if (c.get_model()) {
+      R = c.get_model()->Whiten(R);
+      S = c.get_model()->Whiten(S);
+    }
+    const DenseIndex nF = R.rows(), nS = S.cols();
+
+    // Offsets of the clique variables in the joint covariance
+    CovarianceData myData(parentData.recursion);
+    DenseIndex offset = 0;
+    for (auto it = c.begin(); it != c.end(); ++it) {
+      const DenseIndex d = c.getDim(it);
+      myData.blocks.emplace(*it, std::make_pair(offset, d));
+      offset += d;
+    }
+
+    // Separator covariance, from the joint covariance of the parent clique
+    Matrix Sigma_SS(nS, nS);
+    for (auto i = c.beginParents(); i != c.endParents(); ++i) {
+      const DenseIndex oi = myData.blocks.at(*i).first - nF;
+      for (auto j = c.beginParents(); j != c.endParents(); ++j) {
+        const auto& bj = myData.blocks.at(*j);
+        Sigma_SS.block(oi, bj.first - nF, c.getDim(i), bj.second) = parentData.block(*i, *j);
+      }
+    }
+
+    // Takahashi recursion for this clique
+    const auto Rupper = R.triangularView<Eigen::Upper>();
+    const Matrix Sigma_FS = Rupper.solve(-S * Sigma_SS);
+    const Matrix Rinv_T =
+        R.transpose().triangularView<Eigen::Lower>().solve(Matrix::Identity(nF, nF));
+    Matrix Sigma_FF = Rupper.solve(Rinv_T - S * Sigma_FS.transpose());
+    Sigma_FF = 0.5 * (Sigma_FF + Sigma_FF.transpose());
+    if (!Sigma_FF.allFinite())
+      throw IndeterminantLinearSystemException(c.front());
+
+    myData.joint.resize(nF + nS, nF + nS);
+    myData.joint.topLeftCorner(nF, nF) = Sigma_FF;
+    myData.joint.topRightCorner(nF, nS) = Sigma_FS;
+    myData.joint.bottomLeftCorner(nS, nF) = Sigma_FS.transpose();
+    myData.joint.bottomRightCorner(nS, nS) = Sigma_SS;
+
+    // Blocks owned by this clique
+    std::vector<std::pair<std::pair<Key, Key>, Matrix> > blocks;
+    for (auto it = c.beginFrontals(); it != c.endFrontals(); ++it)
+      blocks.emplace_back(std::make_pair(*it, *it), myData.block(*it, *it));
+    auto requested = myData.recursion->requests->find(clique.get());
+    if (requested != myData.recursion->requests->end())
+      for (const auto& [i, j] : requested->second)
+        blocks.emplace_back(std::make_pair(i, j), myData.block(i, j));
+
+    std::lock_guard<std::mutex> lock(*myData.recursion->mutex);
+    for (auto& block : blocks)
+      myData.recursion->result->insert(std::move(block));
+    return myData;
+  }
   }  // namespace internal
 
   /* ************************************************************************* */
@@ -63,6 +158,22 @@ namespace gtsam {
     return Base::equals(other, tol);
   }
 
+  /* ************************************************************************* */
+  MemoryUsage GaussianBayesTree::memoryUsage() const
+  {
+    MemoryUsage usage;
+    usage.add("nodes", nodes_.size() * sizeof(Nodes::value_type));
+    for (const auto& [key, clique] : nodes_) {
+      // Count each clique once, at its first frontal variable
+      if (!clique || clique->conditional()->front() != key) continue;
+      usage.add("conditionals", clique->conditional()->memoryUsage());
+      usage.add("cliques", sizeof(Clique) + clique->children.capacity() * sizeof(sharedClique));
+      if (const auto& marginal = clique->cachedSeparatorMarginal())
+        usage.add("cachedMarginals", marginal->memoryUsage());
+    }
+    return usage;
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianBayesTree::optimize() const
   {
@@ -76,6 +187,59 @@ namespace gtsam {
     return GaussianFactorGraph(*this).optimizeGradientSearch();
   }
 
+  /* ************************************************************************* */
+  VectorValues GaussianBayesTree::backSubstitute(const VectorValues& gx) const
+  {
+    gttic(GaussianBayesTree_backSubstitute);
+    // Parents are solved before their children
+    VectorValues result;
+    int rootData = 0;
+    auto visitorPre = [&](const sharedClique& clique, int&) {
+      result.insert(clique->conditional()->solveOtherRHS(result, gx));
+      return 0;
+    };
+    treeTraversal::DepthFirstForest(*this, rootData, visitorPre);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianBayesTree::backSubstituteTranspose(const VectorValues& gx) const
+  {
+    gttic(GaussianBayesTree_backSubstituteTranspose);
+    // Children are solved before their parents, i.e. first-eliminated first
+    VectorValues gy = gx;
+    int rootData = 0;
+    auto visitorPre = [](const sharedClique&, int&) { return 0; };
+    auto visitorPost = [&](const sharedClique& clique, int&) {
+      clique->conditional()->solveTransposeInPlace(gy);
+    };
+    treeTraversal::DepthFirstForest(*this, rootData, visitorPre, visitorPost);
+    return gy;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianBayesTree::refine(const GaussianFactorGraph& graph,
+                                         const VectorValues& x0, size_t maxIterations,
+                                         double tol) const
+  {
+    gttic(GaussianBayesTree_refine);
+    VectorValues x = x0;
+    const VectorValues gradientAtZero = graph.gradientAtZero();
+    for (size_t iteration = 0; iteration < maxIterations; ++iteration) {
+      // Gradient A'Ax - A'b of the original system, in double precision
+      VectorValues gradient = gradientAtZero;
+      graph.multiplyHessianAdd(1.0, x, gradient);
+
+      // Solve R'R dx = -gradient with the approximate factor
+      const VectorValues correction = backSubstitute(backSubstituteTranspose(gradient));
+      for (auto& [key, value] : x)
+        value -= correction.at(key);
+      if (correction.norm() <= tol * x.norm())
+        break;
+    }
+    return x;
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianBayesTree::gradient(const VectorValues& x0) const {
     return GaussianFactorGraph(*this).gradient(x0);
@@ -122,5 +286,42 @@ namespace gtsam {
     return marginalFactor(key)->information().inverse();
   }
 
+  /* ************************************************************************* */
+  GaussianBayesTree::CovarianceBlocks GaussianBayesTree::covarianceBlocks(
+      const std::vector<std::pair<Key, Key> >& offDiagonal) const
+  {
+    gttic(GaussianBayesTree_covarianceBlocks);
+
+    // Assign each requested pair to a clique that contains both variables
+    internal::CovarianceRecursion::Requests requests;
+    for (const auto& [i, j] : offDiagonal) {
+      const GaussianBayesTreeClique* owner = nullptr;
+      for (Key frontal : {i, j}) {
+        const sharedClique clique = (*this)[frontal];
+        const auto& keys = clique->conditional()->keys();
+        if (std::find(keys.begin(), keys.end(), frontal == i ? j : i) != keys.end()) {
+          owner = clique.get();
+          break;
+        }
+      }
+      if (!owner)
+        throw std::invalid_argument(
+            "GaussianBayesTree::covarianceBlocks: variables " + DefaultKeyFormatter(i) +
+            " and " + DefaultKeyFormatter(j) + " are not in a common clique");
+      requests[owner].emplace_back(i, j);
+    }
+
+    CovarianceBlocks result;
+    std::mutex mutex;
+    internal::CovarianceRecursion recursion{&requests, &result, &mutex};
+    internal::CovarianceData rootData(&recursion);
+    treeTraversal::no_op visitorPost;
+    // Limits OpenMP threads if we're mixing TBB and OpenMP
+    TbbOpenMPMixedScope threadLimiter;
+    treeTraversal::DepthFirstForestParallel(*this, rootData, internal::covarianceRecursion,
+                                            visitorPost);
+    return result;
+  }
+
 
 } // \namespace gtsam
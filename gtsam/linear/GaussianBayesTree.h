@@ -19,11 +19,16 @@
 
 #pragma once
 
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/BayesTreeCliqueBase.h>
 
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace gtsam {
 
   // Forward declarations
@@ -57,12 +62,22 @@ namespace gtsam {
     typedef GaussianBayesTree This;
     typedef std::shared_ptr<This> shared_ptr;
 
+    /// Covariance blocks indexed by pairs of variables, see covarianceBlocks()
+    typedef std::map<std::pair<Key, Key>, Matrix> CovarianceBlocks;
+
     /** Default constructor, creates an empty Bayes tree */
     GaussianBayesTree() {}
 
     /** Check equality */
     bool equals(const This& other, double tol = 1e-9) const;
 
+    /**
+     * Bytes used by this Bayes tree: the "conditionals", the "cliques" themselves with their
+     * lists of children, the "nodes" index from keys to cliques, and any "cachedMarginals" on
+     * the separators.  The cost is linear in the number of variables.
+     */
+    MemoryUsage memoryUsage() const;
+
     /** Recursively optimize the BayesTree to produce a vector solution. */
     VectorValues optimize() const;
 
@@ -93,6 +108,33 @@ namespace gtsam {
      * \f[ \delta x = \hat\alpha g = \frac{-g^T g}{(R g)^T(R g)} \f] */
     VectorValues optimizeGradientSearch() const;
 
+    /**
+     * Backsubstitute with a different RHS vector than the one stored in this Bayes tree, from
+     * the roots to the leaves.  gy=inv(R*inv(Sigma))*gx, see GaussianBayesNet::backSubstitute.
+     */
+    VectorValues backSubstitute(const VectorValues& gx) const;
+
+    /**
+     * Transpose backsubstitute with a different RHS vector than the one stored in this Bayes
+     * tree, from the leaves to the roots.  gy=inv(R'*inv(Sigma))*gx, see
+     * GaussianBayesNet::backSubstituteTranspose.  \c gx needs an entry for every variable.
+     */
+    VectorValues backSubstituteTranspose(const VectorValues& gx) const;
+
+    /**
+     * Iterative refinement of a solution of \c graph, for a Bayes tree that is an inexact
+     * factorization of \c graph, e.g. one eliminated with EliminateCholeskySinglePrecision.
+     * Every iteration computes the residual of the normal equations of \c graph in double
+     * precision, and corrects the solution by solving with this Bayes tree.
+     *
+     * @param graph The graph this Bayes tree was eliminated from
+     * @param x0 The initial solution, typically optimize()
+     * @param maxIterations The maximum number of corrections
+     * @param tol Stop when a correction is smaller than \c tol times the solution, in 2-norm
+     */
+    VectorValues refine(const GaussianFactorGraph& graph, const VectorValues& x0,
+                        size_t maxIterations = 5, double tol = 1e-12) const;
+
     /** Compute the gradient of the energy function, \f$ \nabla_{x=x_0} \left\Vert \Sigma^{-1} R x -
      * d \right\Vert^2 \f$, centered around \f$ x = x_0 \f$. The gradient is \f$ R^T(Rx-d) \f$.
      *
@@ -127,6 +169,25 @@ namespace gtsam {
     /** Return the marginal on the requested variable as a covariance matrix.  See also
     *   marginalFactor(). */
     Matrix marginalCovariance(Key key) const;
+
+    /**
+     * Compute the marginal covariances of all variables at once, with a Takahashi-style recursion
+     * over the tree.  Going from the roots to the leaves, the joint covariance of the frontal and
+     * separator variables of each clique follows from its conditional and the covariance of its
+     * separator, which is part of the joint covariance of the parent clique:
+     * \f[ \Sigma_{FS} = -R^{-1} S \Sigma_{SS}, \qquad
+     *     \Sigma_{FF} = R^{-1} (R^{-T} - S \Sigma_{FS}^T). \f]
+     * Independent subtrees are processed in parallel.  This is much cheaper than calling
+     * marginalCovariance() for every variable, which computes a marginal factor each time.
+     *
+     * @param offDiagonal Pairs of variables whose cross-covariance is also wanted.  Both variables
+     *        of a pair have to be in the same clique, i.e. the pair has to be inside the sparsity
+     *        pattern of the square-root information matrix.
+     * @return The covariance of every variable, stored with key pair \f$ (j, j) \f$, and the
+     *         cross-covariance \f$ \Sigma_{ij} \f$ for each requested pair \f$ (i, j) \f$.
+     * @throw std::invalid_argument if a requested pair does not share a clique. */
+    CovarianceBlocks covarianceBlocks(
+        const std::vector<std::pair<Key, Key> >& offDiagonal = {}) const;
   };
 
   /// traits
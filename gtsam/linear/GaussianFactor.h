@@ -156,6 +156,12 @@ namespace gtsam {
     /// Gradient wrt a key at any values
     virtual Vector gradient(Key key, const VectorValues& x) const = 0;
 
+    /// Bytes used by this factor and its heap storage, not counting a shared
+    /// noise model
+    virtual size_t memoryUsage() const {
+      return sizeof(GaussianFactor) + keys_.capacity() * sizeof(Key);
+    }
+
     // Determine position of a given key
     template <typename CONTAINER>
     static DenseIndex Slot(const CONTAINER& keys, Key key) {
@@ -44,6 +44,14 @@ namespace gtsam {
     return Base::equals(fg, tol);
   }
 
+  /* ************************************************************************* */
+  size_t GaussianFactorGraph::memoryUsage() const {
+    size_t bytes = factors_.capacity() * sizeof(sharedFactor);
+    for (const sharedFactor& factor : factors_)
+      if (factor) bytes += factor->memoryUsage();
+    return bytes;
+  }
+
   /* ************************************************************************* */
   GaussianFactorGraph::Keys GaussianFactorGraph::keys() const {
     KeySet keys;
@@ -118,6 +118,9 @@ namespace gtsam {
 
     /// @}
 
+    /// Bytes used by the factor slots and the factors they hold
+    size_t memoryUsage() const;
+
     /// Check exact equality.
     friend bool operator==(const GaussianFactorGraph& lhs,
                             const GaussianFactorGraph& rhs) {
@@ -19,6 +19,11 @@
 #include <gtsam/inference/JunctionTree-inst.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/inference/VariableIndex.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 namespace gtsam {
 
@@ -28,7 +33,111 @@ namespace gtsam {
 
   /* ************************************************************************* */
   GaussianJunctionTree::GaussianJunctionTree(
-    const GaussianEliminationTree& eliminationTree) :
-  Base(eliminationTree) {}
+    const GaussianEliminationTree& eliminationTree,
+    const AmalgamationParams& amalgamation) :
+  Base(eliminationTree, amalgamation) {}
+
+  /* ************************************************************************* */
+  GaussianJunctionTree::Structure::Structure(const GaussianFactorGraph& graph,
+                                             const Ordering& ordering,
+                                             const AmalgamationParams& amalgamation)
+      : ordering_(ordering) {
+    gttic(GaussianJunctionTree_Structure);
+    // Record the keys of all factors, to check later graphs against
+    factorOffsets_.reserve(graph.size() + 1);
+    for (const auto& factor : graph) {
+      factorOffsets_.push_back(factorKeys_.size());
+      if (factor)
+        factorKeys_.insert(factorKeys_.end(), factor->begin(), factor->end());
+    }
+    factorOffsets_.push_back(factorKeys_.size());
+
+    // Build the junction tree once, the usual way
+    const GaussianEliminationTree etree(graph, VariableIndex(graph), ordering);
+    const GaussianJunctionTree junctionTree(etree, amalgamation);
+
+    // Factors are shared with the graph, so we can recover their indices.  The
+    // same factor may appear in several slots, each slot is used once.
+    std::unordered_map<const GaussianFactor*, FactorIndices> slots;
+    for (size_t i = graph.size(); i-- > 0;)
+      if (graph[i]) slots[graph[i].get()].push_back(i);
+    auto factorIndex = [&slots](const GaussianFactor* factor) {
+      FactorIndices& indices = slots.at(factor);
+      const size_t i = indices.back();
+      indices.pop_back();
+      return i;
+    };
+
+    // Flatten the tree without recursion, as chains give very deep trees.  A
+    // pre-order traversal visits parents before children, so reversing it
+    // stores children before parents.
+    FastVector<std::pair<sharedNode, size_t>> preOrder;  // cluster and parent
+    const size_t none = std::numeric_limits<size_t>::max();
+    FastVector<std::pair<sharedNode, size_t>> stack;
+    for (auto root = junctionTree.roots().rbegin(); root != junctionTree.roots().rend(); ++root)
+      stack.emplace_back(*root, none);
+    while (!stack.empty()) {
+      auto [cluster, parent] = stack.back();
+      stack.pop_back();
+      const size_t index = preOrder.size();
+      preOrder.emplace_back(cluster, parent);
+      for (auto child = cluster->children.rbegin(); child != cluster->children.rend(); ++child)
+        stack.emplace_back(*child, index);
+    }
+
+    const size_t n = preOrder.size();
+    nodes_.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+      const auto& [cluster, parent] = preOrder[k];
+      Node& node = nodes_[n - 1 - k];
+      node.orderedFrontalKeys = cluster->orderedFrontalKeys;
+      node.factors.reserve(cluster->factors.size());
+      for (const auto& factor : cluster->factors)
+        node.factors.push_back(factorIndex(factor.get()));
+      node.problemSize = cluster->problemSize();
+      node.nrSeparatorKeys = cluster->nrSeparatorKeys_;
+      if (parent == none)
+        roots_.push_back(n - 1 - k);
+      else
+        nodes_[n - 1 - parent].children.push_back(n - 1 - k);
+    }
+    for (const auto& factor : junctionTree.remainingFactors())
+      remainingFactors_.push_back(factorIndex(factor.get()));
+  }
+
+  /* ************************************************************************* */
+  bool GaussianJunctionTree::Structure::matches(const GaussianFactorGraph& graph) const {
+    if (graph.size() + 1 != factorOffsets_.size()) return false;
+    for (size_t i = 0; i < graph.size(); ++i) {
+      const size_t nrKeys = graph[i] ? graph[i]->size() : 0;
+      if (factorOffsets_[i + 1] - factorOffsets_[i] != nrKeys) return false;
+      if (graph[i] && !std::equal(graph[i]->begin(), graph[i]->end(),
+                                  factorKeys_.begin() + factorOffsets_[i]))
+        return false;
+    }
+    return true;
+  }
+
+  /* ************************************************************************* */
+  GaussianJunctionTree::GaussianJunctionTree(const GaussianFactorGraph& graph,
+                                             const Structure& structure) {
+    gttic(GaussianJunctionTree_FromStructure);
+    // Nodes are stored children first, so the children of a node always exist
+    // by the time we create it.
+    FastVector<sharedNode> clusters(structure.nodes_.size());
+    for (size_t j = 0; j < structure.nodes_.size(); ++j) {
+      const Structure::Node& node = structure.nodes_[j];
+      auto cluster = std::make_shared<Cluster>();
+      cluster->orderedFrontalKeys = node.orderedFrontalKeys;
+      cluster->factors.reserve(node.factors.size());
+      for (size_t i : node.factors) cluster->factors.push_back(graph[i]);
+      for (size_t child : node.children) cluster->children.push_back(clusters[child]);
+      cluster->problemSize_ = node.problemSize;
+      cluster->nrSeparatorKeys_ = node.nrSeparatorKeys;
+      clusters[j] = cluster;
+    }
+    for (size_t root : structure.roots_) addRoot(clusters[root]);
+    for (size_t i : structure.remainingFactors_) remainingFactors_.push_back(graph[i]);
+  }
 
 }
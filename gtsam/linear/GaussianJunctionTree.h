@@ -48,9 +48,61 @@ namespace gtsam {
     * @param structure The set of factors involving each variable.  If this is not
     * precomputed, you can call the Create(const FactorGraph<DERIVEDFACTOR>&)
     * named constructor instead.
+    * @param amalgamation Relaxed supernode amalgamation, by default only cliques with identical
+    * structure are merged.
     * @return The elimination tree
     */
-    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+                         const AmalgamationParams& amalgamation = AmalgamationParams());
+
+    /**
+     * The symbolic structure of a junction tree: its cliques, and for every clique the indices
+     * of the factors assigned to it.  Computing it needs an elimination tree and symbolic
+     * elimination, which only depend on the keys of the factors, so it can be re-used to build
+     * junction trees for any graph with the same keys in the same factor slots, e.g. successive
+     * linearizations of the same nonlinear factor graph.
+     */
+    class GTSAM_EXPORT Structure {
+    public:
+      /// Compute the structure of eliminating \c graph with \c ordering
+      Structure(const GaussianFactorGraph& graph, const Ordering& ordering,
+                const AmalgamationParams& amalgamation = AmalgamationParams());
+
+      /// Whether \c graph has the same keys in the same factor slots as the structure's graph
+      bool matches(const GaussianFactorGraph& graph) const;
+
+      /// The ordering the structure was computed with
+      const Ordering& ordering() const { return ordering_; }
+
+      /// Number of cliques in the junction tree
+      size_t nrCliques() const { return nodes_.size(); }
+
+    private:
+      friend class GaussianJunctionTree;
+
+      /// A clique, with children stored before their parent (post-order)
+      struct Node {
+        Ordering orderedFrontalKeys;
+        FactorIndices factors;
+        FastVector<size_t> children;  ///< Indices of the child nodes
+        int problemSize;
+        size_t nrSeparatorKeys;
+      };
+
+      Ordering ordering_;
+      FastVector<Node> nodes_;
+      FastVector<size_t> roots_;           ///< Indices of the root nodes
+      FactorIndices remainingFactors_;     ///< Factors not involving ordered keys
+      FastVector<size_t> factorOffsets_;   ///< Start of each factor's keys in factorKeys_
+      KeyVector factorKeys_;               ///< Keys of all factors, concatenated
+    };
+
+    /**
+     * Build the junction tree of \c graph from a pre-computed structure, skipping the
+     * elimination tree and symbolic elimination.  \c graph must match the structure, see
+     * Structure::matches.
+     */
+    GaussianJunctionTree(const GaussianFactorGraph& graph, const Structure& structure);
   };
 
 }
@@ -22,6 +22,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/blockDispatch.h>
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/FastMap.h>
@@ -361,13 +362,27 @@ void HessianFactor::updateHessian(const KeyVector& infoKeys,
     for (DenseIndex i = 0; i <= j; ++i) {
       const DenseIndex I = slots[i];  // because i<=j, slots[i] is valid.
 
+      // Use fixed-size kernels for common block dimensions
       if (i == j) {
         assert(I == J);
-        info->updateDiagonalBlock(I, info_.diagonalBlock(i));
+        internal::DispatchBlockDim(info_.getDim(i), [&](auto n) {
+          constexpr int N = decltype(n)::value;
+          if constexpr (N == Eigen::Dynamic)
+            info->updateDiagonalBlock(I, info_.diagonalBlock(i));
+          else
+            info->updateFixedDiagonalBlock<N>(I, info_.diagonalBlock(i));
+        });
       } else {
         assert(i < j);
         assert(I != J);
-        info->updateOffDiagonalBlock(I, J, info_.aboveDiagonalBlock(i, j));
+        internal::DispatchBlockDims(info_.getDim(i), info_.getDim(j), [&](auto m, auto n) {
+          constexpr int M = decltype(m)::value, N = decltype(n)::value;
+          if constexpr (M == Eigen::Dynamic || N == Eigen::Dynamic)
+            info->updateOffDiagonalBlock(I, J, info_.aboveDiagonalBlock(i, j));
+          else
+            info->updateFixedOffDiagonalBlock<M, N>(
+                I, J, info_.aboveDiagonalBlock(i, j).template topLeftCorner<M, N>());
+        });
       }
     }
   }
@@ -456,7 +471,8 @@ Vector HessianFactor::gradient(Key key, const VectorValues& x) const {
 }
 
 /* ************************************************************************* */
-std::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Ordering& keys) {
+std::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Ordering& keys,
+                                                                     bool singlePrecision) {
   gttic(HessianFactor_eliminateCholesky);
 
   GaussianConditional::shared_ptr conditional;
@@ -465,7 +481,7 @@ std::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Orde
     // Do dense elimination
     size_t nFrontals = keys.size();
     assert(nFrontals <= size());
-    info_.choleskyPartial(nFrontals);
+    info_.choleskyPartial(nFrontals, singlePrecision);
 
     // TODO(frank): pre-allocate GaussianConditional and write into it
     const VerticalBlockMatrix Ab = info_.split(nFrontals);
@@ -513,10 +529,10 @@ VectorValues HessianFactor::solve() {
 }
 
 /* ************************************************************************* */
-std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
-EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
-  gttic(EliminateCholesky);
-
+// Build the joint factor and eliminate it, in double or single precision
+static std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
+eliminateJointCholesky(const GaussianFactorGraph& factors, const Ordering& keys,
+                       bool singlePrecision) {
   // Build joint factor
   HessianFactor::shared_ptr jointFactor;
   try {
@@ -529,12 +545,26 @@ EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
   }
 
   // Do dense elimination
-  auto conditional = jointFactor->eliminateCholesky(keys);
+  auto conditional = jointFactor->eliminateCholesky(keys, singlePrecision);
 
   // Return result
   return make_pair(conditional, jointFactor);
 }
 
+/* ************************************************************************* */
+std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
+EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholesky);
+  return eliminateJointCholesky(factors, keys, false);
+}
+
+/* ************************************************************************* */
+std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
+EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholeskySinglePrecision);
+  return eliminateJointCholesky(factors, keys, true);
+}
+
 /* ************************************************************************* */
 std::pair<std::shared_ptr<GaussianConditional>,
     std::shared_ptr<GaussianFactor> > EliminatePreferCholesky(
@@ -344,11 +344,18 @@ namespace gtsam {
      */
     Vector gradient(Key key, const VectorValues& x) const override;
 
+    /// Bytes used by this factor, its keys and the augmented information matrix
+    size_t memoryUsage() const override {
+      return sizeof(HessianFactor) + keys_.capacity() * sizeof(Key) + info_.memoryUsage();
+    }
+
     /**
      *  In-place elimination that returns a conditional on (ordered) keys specified, and leaves
-     *  this factor to be on the remaining keys (separator) only. Does dense partial Cholesky.
+     *  this factor to be on the remaining keys (separator) only. Does dense partial Cholesky,
+     *  in single precision if \c singlePrecision is true.
      */
-    std::shared_ptr<GaussianConditional> eliminateCholesky(const Ordering& keys);
+    std::shared_ptr<GaussianConditional> eliminateCholesky(const Ordering& keys,
+                                                           bool singlePrecision = false);
 
       /// Solve the system A'*A delta = A'*b in-place, return delta as VectorValues
     VectorValues solve();
@@ -393,6 +400,19 @@ namespace gtsam {
 GTSAM_EXPORT std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
   EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+/**
+*   Densely partially eliminate with Cholesky factorization as EliminateCholesky(), but with the
+*   dense factorization computed in single precision.  The resulting conditional is only accurate
+*   to single precision, use GaussianBayesTree::refine() to recover a double precision solution.
+*
+*   @param factors Factors to combine and eliminate
+*   @param keys The variables to eliminate and their elimination ordering
+*   @return The conditional and remaining factor
+*
+*   \ingroup LinearSolving */
+GTSAM_EXPORT std::pair<std::shared_ptr<GaussianConditional>, std::shared_ptr<HessianFactor> >
+  EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys);
+
 /**
 *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
 *   left-multiplied with their transpose to form the Hessian using the conversion constructor
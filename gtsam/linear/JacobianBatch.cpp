@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    JacobianBatch.cpp
+ * @brief   Whitened Jacobians of many factors of one shape, in one buffer
+ */
+
+#include <gtsam/linear/JacobianBatch.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+JacobianBatch::JacobianBatch(DenseIndex rows,
+                             const std::vector<DenseIndex>& dims, size_t n) {
+  reset(rows, dims, n);
+}
+
+/* ************************************************************************* */
+void JacobianBatch::reset(DenseIndex rows, const std::vector<DenseIndex>& dims,
+                          size_t n) {
+  n_ = n;
+  rows_ = rows;
+  offsets_.assign(1, 0);
+  for (DenseIndex dim : dims) offsets_.push_back(offsets_.back() + dim);
+  cols_ = offsets_.back() + 1;
+  keys_.resize(n * dims.size());
+  data_.resize(rows_, n * cols_);
+}
+
+/* ************************************************************************* */
+JacobianFactor::shared_ptr JacobianBatch::jacobianFactor(size_t k) const {
+  std::vector<DenseIndex> dims;
+  for (size_t j = 0; j < nrKeys(); ++j)
+    dims.push_back(offsets_[j + 1] - offsets_[j]);
+  dims.push_back(1);
+  VerticalBlockMatrix Ab(dims, rows_);
+  Ab.matrix() = this->Ab(k);
+  const KeyVector keys(keys_.begin() + k * nrKeys(),
+                       keys_.begin() + (k + 1) * nrKeys());
+  return std::make_shared<JacobianFactor>(keys, Ab);
+}
+
+}  // namespace gtsam
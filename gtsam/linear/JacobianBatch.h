@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    JacobianBatch.h
+ * @brief   Whitened Jacobians of many factors of one shape, in one buffer
+ */
+
+#pragma once
+
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/base/Matrix.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Linearizations [A_1 ... A_m b] of a batch of factors that all have m keys,
+ * the same key dimensions and the same number of rows, such as all
+ * BetweenFactor<Pose3> of a pose graph.  The augmented matrices are stored
+ * one after the other in a single column-major buffer, so each factor's
+ * matrix is one contiguous block and the whole batch is filled without any
+ * allocation per factor.  See BetweenFactor::LinearizeBatch.
+ */
+class GTSAM_EXPORT JacobianBatch {
+ public:
+  typedef Eigen::Block<Matrix> Block;
+  typedef Eigen::Block<const Matrix> ConstBlock;
+
+  /// Empty batch
+  JacobianBatch() : n_(0), rows_(0), cols_(1), offsets_(1, 0) {}
+
+  /// Batch of \c n factors with \c rows rows and the given key dimensions
+  JacobianBatch(DenseIndex rows, const std::vector<DenseIndex>& dims,
+                size_t n = 0);
+
+  /// Change the shape and number of factors, keeping the storage if the
+  /// total size does not change; the contents are left undefined
+  void reset(DenseIndex rows, const std::vector<DenseIndex>& dims, size_t n);
+
+  /// Number of factors
+  size_t size() const { return n_; }
+
+  /// Number of keys of each factor
+  size_t nrKeys() const { return offsets_.size() - 1; }
+
+  /// Number of rows of each factor
+  DenseIndex rows() const { return rows_; }
+
+  /// Key \c j of factor \c k
+  Key& key(size_t k, size_t j) { return keys_[k * nrKeys() + j]; }
+  Key key(size_t k, size_t j) const { return keys_[k * nrKeys() + j]; }
+
+  /// Augmented matrix [A_1 ... A_m b] of factor \c k
+  Block Ab(size_t k) { return data_.block(0, k * cols_, rows_, cols_); }
+  ConstBlock Ab(size_t k) const {
+    return data_.block(0, k * cols_, rows_, cols_);
+  }
+
+  /// Jacobian block of key \c j of factor \c k
+  Block A(size_t k, size_t j) {
+    return data_.block(0, k * cols_ + offsets_[j], rows_,
+                       offsets_[j + 1] - offsets_[j]);
+  }
+  ConstBlock A(size_t k, size_t j) const {
+    return data_.block(0, k * cols_ + offsets_[j], rows_,
+                       offsets_[j + 1] - offsets_[j]);
+  }
+
+  /// Right-hand side of factor \c k
+  Matrix::ColXpr b(size_t k) { return data_.col((k + 1) * cols_ - 1); }
+  Matrix::ConstColXpr b(size_t k) const {
+    return data_.col((k + 1) * cols_ - 1);
+  }
+
+  /// The whole buffer, the matrix of factor k in columns [k*cols, (k+1)*cols)
+  const Matrix& matrix() const { return data_; }
+
+  /// Copy of factor \c k as a JacobianFactor
+  JacobianFactor::shared_ptr jacobianFactor(size_t k) const;
+
+ private:
+  size_t n_;
+  DenseIndex rows_;
+  DenseIndex cols_;  ///< columns of one factor, including b
+  std::vector<DenseIndex> offsets_;  ///< first column of each key, then of b
+  KeyVector keys_;
+  Matrix data_;
+};
+
+}  // namespace gtsam
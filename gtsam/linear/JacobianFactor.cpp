@@ -29,6 +29,7 @@
 #include <gtsam/base/timing.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/FastMap.h>
+#include <gtsam/base/blockDispatch.h>
 #include <gtsam/base/cholesky.h>
 
 #include <cmath>
@@ -586,13 +587,31 @@ void JacobianFactor::updateHessian(const KeyVector& infoKeys,
       Eigen::Block<const Matrix> Ab_j = Ab_(j);
       const DenseIndex J = (j == n) ? N : Slot(infoKeys, keys_[j]);
       slots[j] = J;
-      // Fill off-diagonal blocks with Ai'*Aj
+      // Fill off-diagonal blocks with Ai'*Aj, with fixed-size products for common block
+      // dimensions: these are coefficient-based, as factors have few rows
       for (DenseIndex i = 0; i < j; ++i) {
         const DenseIndex I = slots[i];  // because i<j, slots[i] is valid.
-        info->updateOffDiagonalBlock(I, J, Ab_(i).transpose() * Ab_j);
+        internal::DispatchBlockDims(Ab_(i).cols(), Ab_j.cols(), [&](auto m, auto n) {
+          constexpr int M = decltype(m)::value, N = decltype(n)::value;
+          if constexpr (M == Eigen::Dynamic || N == Eigen::Dynamic)
+            info->updateOffDiagonalBlock(I, J, Ab_(i).transpose() * Ab_j);
+          else
+            info->updateFixedOffDiagonalBlock<M, N>(
+                I, J, Ab_(i).template leftCols<M>().transpose().lazyProduct(
+                          Ab_j.template leftCols<N>()));
+        });
       }
       // Fill diagonal block with Aj'*Aj
-      info->diagonalBlock(J).rankUpdate(Ab_j.transpose());
+      internal::DispatchBlockDim(Ab_j.cols(), [&](auto n) {
+        constexpr int N = decltype(n)::value;
+        if constexpr (N == Eigen::Dynamic) {
+          info->diagonalBlock(J).rankUpdate(Ab_j.transpose());
+        } else {
+          const auto Aj = Ab_j.template leftCols<N>();
+          const Eigen::Matrix<double, N, N> AjtAj = Aj.transpose().lazyProduct(Aj);
+          info->updateFixedDiagonalBlock<N>(J, AjtAj);
+        }
+      });
     }
   }
 }
@@ -351,6 +351,11 @@ namespace gtsam {
     /// Compute the gradient wrt a key at any values
     Vector gradient(Key key, const VectorValues& x) const override;
 
+    /// Bytes used by this factor, its keys and the augmented matrix
+    size_t memoryUsage() const override {
+      return sizeof(JacobianFactor) + keys_.capacity() * sizeof(Key) + Ab_.memoryUsage();
+    }
+
     /** Return a whitened version of the factor, i.e. with unit diagonal noise model. */
     JacobianFactor whiten() const;
 
@@ -19,8 +19,10 @@
 
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/internal/parallelFor.h>
 
 #include <algorithm>
 #include <iostream>
@@ -75,6 +77,47 @@ GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
         lambda) {
+  /* flat index of the variables touched by every factor */
+  const size_t nrVariables = keyInfo.size();
+  variableStarts_.resize(nrVariables);
+  variableDims_.resize(nrVariables);
+  for (const KeyInfo::value_type &item : keyInfo) {
+    variableStarts_[item.second.index] = item.second.start;
+    variableDims_[item.second.index] = item.second.dim;
+  }
+
+  std::vector<size_t> termVariables;
+  factorTerms_.assign(1, 0);
+  jacobians_.resize(gfg.size(), nullptr);
+  informations_.resize(gfg.size());
+  size_t scratchSize = 0;
+  for (size_t f = 0; f < gfg.size(); ++f) {
+    const auto &factor = gfg[f];
+    if (factor) {
+      jacobians_[f] = dynamic_cast<const JacobianFactor *>(factor.get());
+      if (!jacobians_[f]) informations_[f] = factor->information();
+      for (Key key : *factor) {
+        const KeyInfoEntry &entry = keyInfo.at(key);
+        termVariables.push_back(entry.index);
+        termStarts_.push_back(entry.start);
+        termDims_.push_back(entry.dim);
+        scratchStarts_.push_back(scratchSize);
+        scratchSize += entry.dim;
+      }
+    }
+    factorTerms_.push_back(termStarts_.size());
+  }
+  scratch_.resize(scratchSize);
+
+  /* transpose: the terms of every variable, in factor order */
+  variableTerms_.assign(nrVariables + 1, 0);
+  for (size_t v : termVariables) ++variableTerms_[v + 1];
+  for (size_t v = 0; v < nrVariables; ++v)
+    variableTerms_[v + 1] += variableTerms_[v];
+  terms_.resize(termVariables.size());
+  std::vector<size_t> next(variableTerms_.begin(), variableTerms_.end() - 1);
+  for (size_t t = 0; t < termVariables.size(); ++t)
+    terms_[next[termVariables[t]]++] = t;
 }
 
 /*****************************************************************************/
@@ -93,18 +136,46 @@ void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
 /*****************************************************************************/
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
-
-  // Build a VectorValues for Vector x
-  VectorValues vvX = buildVectorValues(x, keyInfo_);
-
-  // VectorValues form of A'Ax for multiplyHessianAdd
-  VectorValues vvAtAx = keyInfo_.x0(); // crucial for performance
-
-  // vvAtAx += 1.0 * A'Ax for each factor
-  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx);
-
-  // Make the result as Vector form
-  AtAx = vvAtAx.vector(keyInfo_.ordering());
+  typedef Eigen::Map<const Vector> ConstVectorMap;
+  AtAx.resize(keyInfo_.numCols());
+
+  // Each factor writes A_f^T A_f x_f into its own slice of the scratch buffer
+  internal::parallelFor(gfg_.size(), [&](size_t f) {
+    const size_t begin = factorTerms_[f], end = factorTerms_[f + 1];
+    if (begin == end) return;
+    if (const JacobianFactor *jacobian = jacobians_[f]) {
+      Vector Ax = Vector::Zero(jacobian->rows());
+      for (size_t t = begin; t < end; ++t)
+        Ax += jacobian->getA(jacobian->begin() + (t - begin)) *
+              ConstVectorMap(x.data() + termStarts_[t], termDims_[t]);
+      // Double whiten, as we are dividing by the variance
+      if (const auto &model = jacobian->get_model()) {
+        model->whitenInPlace(Ax);
+        model->whitenInPlace(Ax);
+      }
+      for (size_t t = begin; t < end; ++t)
+        scratch_.segment(scratchStarts_[t], termDims_[t]).noalias() =
+            jacobian->getA(jacobian->begin() + (t - begin)).transpose() * Ax;
+    } else {
+      const Matrix &information = informations_[f];
+      const size_t dim = information.rows();
+      Vector xf(dim);
+      for (size_t t = begin, i = 0; t < end; i += termDims_[t], ++t)
+        xf.segment(i, termDims_[t]) =
+            ConstVectorMap(x.data() + termStarts_[t], termDims_[t]);
+      scratch_.segment(scratchStarts_[begin], dim).noalias() = information * xf;
+    }
+  });
+
+  // Each variable sums the slices of its factors, in factor order
+  internal::parallelFor(variableStarts_.size(), [&](size_t v) {
+    auto result = AtAx.segment(variableStarts_[v], variableDims_[v]);
+    result.setZero();
+    for (size_t i = variableTerms_[v]; i < variableTerms_[v + 1]; ++i) {
+      const size_t t = terms_[i];
+      result += scratch_.segment(scratchStarts_[t], termDims_[t]);
+    }
+  });
 }
 
 /*****************************************************************************/
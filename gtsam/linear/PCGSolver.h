@@ -20,11 +20,14 @@
 #pragma once
 
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/base/Matrix.h>
 #include <string>
+#include <vector>
 
 namespace gtsam {
 
 class GaussianFactorGraph;
+class JacobianFactor;
 class KeyInfo;
 class Preconditioner;
 class VectorValues;
@@ -85,6 +88,13 @@ public:
 
 /**
  * System class needed for calling preconditionedConjugateGradient
+ *
+ * The Hessian-vector product in multiply() is matrix-free and works directly on
+ * the raw vectors laid out by the KeyInfo: at construction, the offset of every
+ * variable of every factor is looked up once.  Each product then evaluates the
+ * factors in parallel, each writing its A_f^T A_f x_f into its own slice of a
+ * scratch buffer, and sums the slices per variable in parallel, in factor order,
+ * so the result does not depend on the number of threads.
  */
 class GTSAM_EXPORT GaussianFactorGraphSystem {
 public:
@@ -98,6 +108,22 @@ public:
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
 
+private:
+  // One term per (factor, variable) pair, stored factor by factor
+  std::vector<size_t> factorTerms_;   ///< first term of each factor, size #factors+1
+  std::vector<size_t> termStarts_;    ///< start of the term's variable in x
+  std::vector<size_t> termDims_;      ///< dimension of the term's variable
+  std::vector<size_t> scratchStarts_; ///< start of the term's slice in scratch_
+  std::vector<const JacobianFactor*> jacobians_; ///< null for other factor types
+  std::vector<Matrix> informations_;  ///< information of non-Jacobian factors
+  // Terms of each variable, in factor order
+  std::vector<size_t> variableTerms_; ///< first entry in terms_, size #variables+1
+  std::vector<size_t> terms_;
+  std::vector<size_t> variableStarts_, variableDims_;
+  mutable Vector scratch_;
+
+public:
+
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
   void leftPrecondition(const Vector &x, Vector &y) const;
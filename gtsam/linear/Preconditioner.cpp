@@ -12,6 +12,10 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/linear/internal/parallelFor.h>
+
+#include <algorithm>
 #include <memory>
 #include <iostream>
 #include <vector>
@@ -130,27 +134,52 @@ void BlockJacobiPreconditioner::build(
 {
   // n is the number of keys
   const size_t n = keyInfo.size();
-  // dims_ is a vector that contains the dimension of keys
+  // dims_ is a vector that contains the dimension of keys, in keyInfo order
   dims_ = keyInfo.colSpec();
 
-  /* prepare the buffer of block diagonals */
-  std::vector<Matrix> blocks; blocks.reserve(n);
-
-  /* allocate memory for the factorization of block diagonals */
-  size_t nnz = 0;
-  for ( size_t i = 0 ; i < n ; ++i ) {
-    const size_t dim = dims_[i];
-    // blocks.push_back(Matrix::Zero(dim, dim));
-    // nnz += (((dim)*(dim+1)) >> 1); // d*(d+1) / 2  ;
-    nnz += dim*dim;
+  /* reuse the cached diagonal blocks of factors seen in the last build, find the rest */
+  BlockCache cache;
+  std::vector<const FactorBlocks*> summands;
+  std::vector<std::pair<const GaussianFactor*, FactorBlocks*> > added;
+  for (const auto &factor : gfg) {
+    if (!factor) continue;
+    const auto [it, inserted] = cache.emplace(factor, FactorBlocks());
+    if (inserted) {
+      const auto previous = cache_.find(factor);
+      if (previous != cache_.end())
+        it->second = std::move(previous->second);
+      else
+        added.emplace_back(factor.get(), &it->second);
+    }
+    summands.push_back(&it->second);
   }
-
-  /* getting the block diagonals over the factors */
-  std::map<Key, Matrix> hessianMap =gfg.hessianBlockDiagonal();
-  for (const auto& [key, hessian]: hessianMap) {
-    blocks.push_back(hessian);
+  nrUpdatedFactors_ = added.size();
+
+  /* compute the diagonal blocks of the new factors in parallel */
+  internal::parallelFor(added.size(), [&](size_t i) {
+    *added[i].second = added[i].first->hessianBlockDiagonal();
+  });
+
+  /* drops the blocks of the factors that are no longer in the graph */
+  cache_ = std::move(cache);
+
+  /* sum from scratch in factor order, so the result does not depend on earlier builds */
+  std::map<Key, Matrix> diagonal;
+  for (const FactorBlocks *blocks : summands) {
+    for (const auto &[key, block] : *blocks) {
+      auto it = diagonal.find(key);
+      if (it == diagonal.end())
+        diagonal.emplace(key, block);
+      else
+        it->second += block;
+    }
   }
 
+  /* allocate memory for the factorization of block diagonals */
+  std::vector<size_t> offsets(n + 1, 0);
+  for ( size_t i = 0 ; i < n ; ++i ) offsets[i + 1] = offsets[i] + dims_[i] * dims_[i];
+  const size_t nnz = offsets[n];
+
   /* if necessary, allocating the memory for cacheing the factorization results */
   if ( nnz > bufferSize_ ) {
     clean();
@@ -159,20 +188,16 @@ void BlockJacobiPreconditioner::build(
   }
   nnz_ = nnz;
 
-  /* factorizing the blocks respectively */
-  double *ptr = buffer_;
-  for ( size_t i = 0 ; i < n ; ++i ) {
+  /* factorizing the blocks in parallel, in the order of the keyInfo ordering */
+  const Ordering &ordering = keyInfo.ordering();
+  internal::parallelFor(n, [&](size_t i) {
     /* use eigen to decompose Di */
     /* It is same as L = chol(M,'lower') in MATLAB where M is full preconditioner */
-    const Matrix L = blocks[i].llt().matrixL();
+    const Matrix L = diagonal.at(ordering[i]).llt().matrixL();
 
     /* store the data in the buffer */
-    size_t sz = dims_[i]*dims_[i] ;
-    std::copy(L.data(), L.data() + sz, ptr);
-
-    /* advance the pointer */
-    ptr += sz;
-  }
+    std::copy(L.data(), L.data() + dims_[i] * dims_[i], buffer_ + offsets[i]);
+  });
 }
 
 /*****************************************************************************/
@@ -185,6 +210,136 @@ void BlockJacobiPreconditioner::clean() {
   }
 }
 
+/***************************************************************************************/
+void IncompleteCholeskyPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "IncompleteCholeskyPreconditionerParameters" << endl
+     << "initialShift:     " << initialShift << endl
+     << "maxShiftAttempts: " << maxShiftAttempts << endl;
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  /* forward substitution, x = L^{-1} y */
+  x = y;
+  for (size_t j = 0; j < columns_.size(); ++j) {
+    const BlockColumn &column = columns_[j];
+    auto xj = x.segment(offsets_[j], offsets_[j + 1] - offsets_[j]);
+    column.blocks[0].triangularView<Eigen::Lower>().solveInPlace(xj);
+    for (size_t a = 1; a < column.rows.size(); ++a) {
+      const size_t i = column.rows[a];
+      x.segment(offsets_[i], offsets_[i + 1] - offsets_[i]).noalias() -=
+          column.blocks[a] * xj;
+    }
+  }
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  /* backward substitution, x = L^{-T} y */
+  x = y;
+  for (size_t j = columns_.size(); j-- > 0;) {
+    const BlockColumn &column = columns_[j];
+    auto xj = x.segment(offsets_[j], offsets_[j + 1] - offsets_[j]);
+    for (size_t a = 1; a < column.rows.size(); ++a) {
+      const size_t i = column.rows[a];
+      xj.noalias() -= column.blocks[a].transpose() *
+                      x.segment(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+    column.blocks[0].transpose().triangularView<Eigen::Upper>().solveInPlace(xj);
+  }
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  const Ordering &ordering = keyInfo.ordering();
+  const size_t n = ordering.size();
+  const std::vector<size_t> dims = keyInfo.colSpec();
+  offsets_.assign(n + 1, 0);
+  for (size_t i = 0; i < n; ++i) offsets_[i + 1] = offsets_[i] + dims[i];
+
+  /* block sparsity pattern of the lower triangle of the Hessian */
+  std::vector<std::vector<size_t> > factorPositions;
+  factorPositions.reserve(gfg.size());
+  columns_.assign(n, BlockColumn());
+  for (size_t j = 0; j < n; ++j) columns_[j].rows.push_back(j);
+  for (const auto &factor : gfg) {
+    factorPositions.emplace_back();
+    if (!factor) continue;
+    for (Key key : *factor) factorPositions.back().push_back(keyInfo.at(key).index);
+    for (size_t pa : factorPositions.back())
+      for (size_t pb : factorPositions.back())
+        if (pa > pb) columns_[pb].rows.push_back(pa);
+  }
+  for (size_t j = 0; j < n; ++j) {
+    std::vector<size_t> &rows = columns_[j].rows;
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    for (size_t i : rows) columns_[j].blocks.push_back(Matrix::Zero(dims[i], dims[j]));
+  }
+
+  /* assemble the Hessian blocks from the factors' information matrices */
+  for (size_t f = 0; f < gfg.size(); ++f) {
+    if (!gfg[f]) continue;
+    const std::vector<size_t> &positions = factorPositions[f];
+    const Matrix info = gfg[f]->augmentedInformation();
+    std::vector<size_t> infoOffsets(1, 0);
+    for (size_t pa : positions) infoOffsets.push_back(infoOffsets.back() + dims[pa]);
+    for (size_t b = 0; b < positions.size(); ++b) {
+      BlockColumn &column = columns_[positions[b]];
+      for (size_t a = 0; a < positions.size(); ++a) {
+        if (positions[a] < positions[b]) continue;
+        const size_t index = std::lower_bound(column.rows.begin(), column.rows.end(),
+                                              positions[a]) - column.rows.begin();
+        column.blocks[index] += info.block(infoOffsets[a], infoOffsets[b],
+                                           dims[positions[a]], dims[positions[b]]);
+      }
+    }
+  }
+
+  /* factorize, shifting the diagonal if the incomplete factorization breaks down */
+  const std::vector<BlockColumn> hessian = columns_;
+  shift_ = 0.0;
+  for (size_t attempt = 0; !factorize(); ++attempt) {
+    if (attempt == parameters_.maxShiftAttempts)
+      throw IndeterminantLinearSystemException(n > 0 ? ordering[0] : Key(0));
+    shift_ = (shift_ == 0.0) ? parameters_.initialShift : 2.0 * shift_;
+    columns_ = hessian;
+    for (BlockColumn &column : columns_)
+      column.blocks[0].diagonal() *= (1.0 + shift_);
+  }
+}
+
+/***************************************************************************************/
+bool IncompleteCholeskyPreconditioner::factorize() {
+  for (size_t j = 0; j < columns_.size(); ++j) {
+    BlockColumn &column = columns_[j];
+    Eigen::LLT<Matrix> llt(column.blocks[0]);
+    if (llt.info() != Eigen::Success) return false;
+    column.blocks[0] = llt.matrixL();
+
+    /* L_ij = A_ij * L_jj^{-T} */
+    const auto Ljj = column.blocks[0].transpose().triangularView<Eigen::Upper>();
+    for (size_t a = 1; a < column.rows.size(); ++a)
+      Ljj.solveInPlace<Eigen::OnTheRight>(column.blocks[a]);
+
+    /* A_ik -= L_ij * L_kj^T for blocks (i,k) in the pattern, fill-in is dropped */
+    for (size_t b = 1; b < column.rows.size(); ++b) {
+      BlockColumn &target = columns_[column.rows[b]];
+      for (size_t a = b; a < column.rows.size(); ++a) {
+        const auto it = std::lower_bound(target.rows.begin(), target.rows.end(),
+                                         column.rows[a]);
+        if (it == target.rows.end() || *it != column.rows[a]) continue;
+        target.blocks[it - target.rows.begin()].noalias() -=
+            column.blocks[a] * column.blocks[b].transpose();
+      }
+    }
+  }
+  return true;
+}
+
 /***************************************************************************************/
 std::shared_ptr<Preconditioner> createPreconditioner(
     const std::shared_ptr<PreconditionerParameters> params) {
@@ -194,6 +349,10 @@ std::shared_ptr<Preconditioner> createPreconditioner(
   } else if (dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(
                  params)) {
     return std::make_shared<BlockJacobiPreconditioner>();
+  } else if (auto ic =
+                 dynamic_pointer_cast<IncompleteCholeskyPreconditionerParameters>(
+                     params)) {
+    return std::make_shared<IncompleteCholeskyPreconditioner>(*ic);
   } else if (auto subgraph =
                  dynamic_pointer_cast<SubgraphPreconditionerParameters>(
                      params)) {
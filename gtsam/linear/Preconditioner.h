@@ -13,9 +13,11 @@
 #include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace gtsam {
 
+class GaussianFactor;
 class GaussianFactorGraph;
 class KeyInfo;
 class VectorValues;
@@ -128,6 +130,12 @@ struct GTSAM_EXPORT BlockJacobiPreconditionerParameters : public PreconditionerP
 };
 
 /*******************************************************************************************/
+/* Block-Jacobi preconditioner.  The diagonal blocks are accumulated and factorized in
+ * parallel.  The diagonal blocks of every factor are cached, keyed by the identity of the
+ * factor (without keeping it alive), so rebuilding for a graph that shares most factors
+ * with the previous one (e.g. the same linearization with different LM damping factors)
+ * only computes the blocks of the new factors.  The blocks are summed from scratch on
+ * every build, so the result is the same as that of a fresh preconditioner. */
 class GTSAM_EXPORT BlockJacobiPreconditioner : public Preconditioner {
 public:
   typedef Preconditioner Base;
@@ -143,6 +151,9 @@ public:
     const std::map<Key,Vector> &lambda
     ) override;
 
+  /* number of factors whose diagonal blocks were (re)computed in the last build */
+  size_t nrUpdatedFactors() const { return nrUpdatedFactors_; }
+
 protected:
 
   void clean() ;
@@ -151,6 +162,71 @@ protected:
   double *buffer_;
   size_t bufferSize_;
   size_t nnz_;
+
+  typedef std::map<Key, Matrix> FactorBlocks;
+  typedef std::map<std::weak_ptr<GaussianFactor>, FactorBlocks,
+                   std::owner_less<std::weak_ptr<GaussianFactor> > > BlockCache;
+  BlockCache cache_; ///< diagonal blocks of each factor of the last build
+  size_t nrUpdatedFactors_ = 0;
+};
+
+/*******************************************************************************************/
+struct GTSAM_EXPORT IncompleteCholeskyPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef std::shared_ptr<IncompleteCholeskyPreconditionerParameters> shared_ptr;
+
+  /* If the factorization breaks down, the diagonal is scaled by (1 + shift) and the
+   * factorization restarted, doubling the shift each time, see Manteuffel (1980). */
+  double initialShift = 1e-3;
+  size_t maxShiftAttempts = 20;
+
+  IncompleteCholeskyPreconditionerParameters() : Base() {}
+  ~IncompleteCholeskyPreconditionerParameters() override {}
+
+  void print(std::ostream &os) const override;
+};
+
+/*******************************************************************************************/
+/* Block incomplete Cholesky IC(0) preconditioner.  The Hessian is factorized as L*L^T
+ * on the variable-block structure of the graph, with dense diagonal and off-diagonal
+ * blocks, but any fill-in outside the block sparsity pattern of the Hessian is dropped. */
+class GTSAM_EXPORT IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  IncompleteCholeskyPreconditioner(
+      const IncompleteCholeskyPreconditionerParameters &p =
+          IncompleteCholeskyPreconditionerParameters())
+      : parameters_(p) {}
+  ~IncompleteCholeskyPreconditioner() override {}
+
+  /* Computation Interfaces for raw vector */
+  void solve(const Vector& y, Vector &x) const override;
+  void transposeSolve(const Vector& y, Vector& x) const override;
+  void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) override;
+
+  /* relative diagonal shift needed in the last build, 0 if none */
+  double shift() const { return shift_; }
+
+protected:
+
+  /* the lower-triangular blocks of one block column, the diagonal block first */
+  struct BlockColumn {
+    std::vector<size_t> rows;
+    std::vector<Matrix> blocks;
+  };
+
+  /* factorize columns_ in place, returns false on breakdown */
+  bool factorize();
+
+  IncompleteCholeskyPreconditionerParameters parameters_;
+  std::vector<size_t> offsets_; ///< start of each block in the raw vectors
+  std::vector<BlockColumn> columns_;
+  double shift_ = 0.0;
 };
 
 /*********************************************************************************************/
@@ -0,0 +1,271 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SparseCholeskySolver.cpp
+ * @brief Sparse-matrix Cholesky solver for Gaussian factor graphs
+ */
+
+#include <gtsam/linear/SparseCholeskySolver.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+bool SparseCholeskySolver::matches(const GaussianFactorGraph& gfg) const {
+  if (nrAnalyses_ == 0 || gfg.size() != factorSizes_.size())
+    return false;
+  size_t keyIndex = 0;
+  for (size_t i = 0; i < gfg.size(); ++i) {
+    const GaussianFactor::shared_ptr& factor = gfg[i];
+    const size_t nrKeys = factor ? factor->size() : 0;
+    if (nrKeys != factorSizes_[i])
+      return false;
+    if (!factor)
+      continue;
+    for (auto it = factor->begin(); it != factor->end(); ++it, ++keyIndex) {
+      if (*it != factorKeys_[keyIndex] ||
+          size_t(factor->getDim(it)) != factorDims_[keyIndex])
+        return false;
+    }
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void SparseCholeskySolver::analyze(const GaussianFactorGraph& gfg,
+                                   const Ordering& ordering) {
+  gttic_(SparseCholeskySolver_analyze);
+  const size_t nrVariables = ordering.size();
+  FastMap<Key, size_t> positions;
+  for (size_t p = 0; p < nrVariables; ++p)
+    positions.emplace(ordering[p], p);
+
+  // Structure signature and variable dimensions
+  factorSizes_.clear();
+  factorKeys_.clear();
+  factorDims_.clear();
+  factorPositions_.clear();
+  std::vector<size_t> dims(nrVariables, 0);
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor) {
+      factorSizes_.push_back(0);
+      continue;
+    }
+    auto jacobian = std::dynamic_pointer_cast<JacobianFactor>(factor);
+    if (jacobian && jacobian->isConstrained())
+      throw std::invalid_argument(
+          "SparseCholeskySolver: constrained noise models are not supported");
+    factorSizes_.push_back(factor->size());
+    for (auto it = factor->begin(); it != factor->end(); ++it) {
+      auto position = positions.find(*it);
+      if (position == positions.end())
+        throw std::invalid_argument(
+            "SparseCholeskySolver: the ordering does not contain all keys of "
+            "the graph");
+      factorKeys_.push_back(*it);
+      factorDims_.push_back(factor->getDim(it));
+      factorPositions_.push_back(position->second);
+      dims[position->second] = factor->getDim(it);
+    }
+  }
+  ordering_ = ordering;
+
+  columnOffsets_.assign(nrVariables + 1, 0);
+  for (size_t p = 0; p < nrVariables; ++p)
+    columnOffsets_[p + 1] = columnOffsets_[p] + dims[p];
+  const size_t n = columnOffsets_.back();
+
+  // Block rows present in each block column, lower triangle only.  The
+  // diagonal block is always present so that unconstrained variables show up
+  // as indeterminant rather than producing an empty column.
+  std::vector<std::vector<size_t> > rowBlocks(nrVariables);
+  for (size_t p = 0; p < nrVariables; ++p)
+    rowBlocks[p].push_back(p);
+  size_t keyIndex = 0;
+  for (size_t nrKeys : factorSizes_) {
+    for (size_t a = 0; a < nrKeys; ++a)
+      for (size_t b = 0; b < nrKeys; ++b) {
+        const size_t pa = factorPositions_[keyIndex + a],
+                     pb = factorPositions_[keyIndex + b];
+        if (pa > pb)
+          rowBlocks[pb].push_back(pa);
+      }
+    keyIndex += nrKeys;
+  }
+
+  // Offset of each block within the columns of its block column
+  std::vector<std::vector<size_t> > blockOffsets(nrVariables);
+  size_t nnz = 0;
+  for (size_t p = 0; p < nrVariables; ++p) {
+    std::vector<size_t>& rows = rowBlocks[p];
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    size_t height = 0;
+    for (size_t row : rows) {
+      blockOffsets[p].push_back(height);
+      height += dims[row];
+    }
+    nnz += height * dims[p];
+  }
+  if (nnz > size_t(std::numeric_limits<int>::max()))
+    throw std::invalid_argument(
+        "SparseCholeskySolver: too many non-zeros for 32-bit sparse indices");
+
+  // Build the CSC pattern
+  hessian_.resize(n, n);
+  hessian_.resizeNonZeros(nnz);
+  int* outer = hessian_.outerIndexPtr();
+  int* inner = hessian_.innerIndexPtr();
+  size_t entry = 0;
+  for (size_t p = 0; p < nrVariables; ++p) {
+    for (size_t col = columnOffsets_[p]; col < columnOffsets_[p + 1]; ++col) {
+      outer[col] = int(entry);
+      for (size_t row : rowBlocks[p])
+        for (size_t r = columnOffsets_[row]; r < columnOffsets_[row + 1]; ++r)
+          inner[entry++] = int(r);
+    }
+  }
+  outer[n] = int(entry);
+  std::fill(hessian_.valuePtr(), hessian_.valuePtr() + nnz, 0.0);
+
+  // Scatter offsets of every lower block pair of every factor, in the order
+  // they are visited in solveAnalyzed
+  pairOffsets_.clear();
+  keyIndex = 0;
+  for (size_t nrKeys : factorSizes_) {
+    for (size_t b = 0; b < nrKeys; ++b)
+      for (size_t a = 0; a < nrKeys; ++a) {
+        const size_t pa = factorPositions_[keyIndex + a],
+                     pb = factorPositions_[keyIndex + b];
+        if (pa < pb)
+          continue;
+        const std::vector<size_t>& rows = rowBlocks[pb];
+        const size_t index =
+            std::lower_bound(rows.begin(), rows.end(), pa) - rows.begin();
+        pairOffsets_.push_back(blockOffsets[pb][index]);
+      }
+    keyIndex += nrKeys;
+  }
+
+  factorization_.analyzePattern(hessian_);
+  ++nrAnalyses_;
+}
+
+/* ************************************************************************* */
+VectorValues SparseCholeskySolver::solveAnalyzed(
+    const GaussianFactorGraph& gfg, const Vector& damping) {
+  // Assemble the normal equations into the fixed pattern
+  gttic_(SparseCholeskySolver_assemble);
+  double* values = hessian_.valuePtr();
+  std::fill(values, values + hessian_.nonZeros(), 0.0);
+  const int* outer = hessian_.outerIndexPtr();
+  rhs_.setZero(columnOffsets_.back());
+
+  std::vector<size_t> infoOffsets;
+  size_t keyIndex = 0, pairIndex = 0;
+  for (size_t i = 0; i < gfg.size(); ++i) {
+    const size_t nrKeys = factorSizes_[i];
+    if (nrKeys == 0)
+      continue;
+    if (!gfg[i]) {
+      // Inactive factor, skip its keys and its nrKeys*(nrKeys+1)/2 blocks
+      keyIndex += nrKeys;
+      pairIndex += nrKeys * (nrKeys + 1) / 2;
+      continue;
+    }
+    const Matrix info = gfg[i]->augmentedInformation();
+    const size_t rhsColumn = info.cols() - 1;
+    infoOffsets.assign(1, 0);
+    for (size_t a = 0; a < nrKeys; ++a)
+      infoOffsets.push_back(infoOffsets.back() + factorDims_[keyIndex + a]);
+
+    for (size_t b = 0; b < nrKeys; ++b) {
+      const size_t pb = factorPositions_[keyIndex + b];
+      const size_t db = factorDims_[keyIndex + b];
+      for (size_t a = 0; a < nrKeys; ++a) {
+        const size_t pa = factorPositions_[keyIndex + a];
+        if (pa < pb)
+          continue;
+        const size_t offset = pairOffsets_[pairIndex++];
+        const size_t da = factorDims_[keyIndex + a];
+        for (size_t col = 0; col < db; ++col) {
+          double* target = values + outer[columnOffsets_[pb] + col] + offset;
+          const double* source = &info(infoOffsets[a], infoOffsets[b] + col);
+          for (size_t row = 0; row < da; ++row)
+            target[row] += source[row];
+        }
+      }
+      rhs_.segment(columnOffsets_[pb], db) +=
+          info.block(infoOffsets[b], rhsColumn, db, 1);
+    }
+    keyIndex += nrKeys;
+  }
+
+  // Each block column starts with its diagonal block
+  if (damping.size() > 0) {
+    if (damping.size() != rhs_.size())
+      throw std::invalid_argument(
+          "SparseCholeskySolver: damping does not match the system dimension");
+    for (size_t p = 0; p + 1 < columnOffsets_.size(); ++p)
+      for (size_t col = columnOffsets_[p]; col < columnOffsets_[p + 1]; ++col)
+        values[outer[col] + (col - columnOffsets_[p])] += damping(col);
+  }
+  gttoc_(SparseCholeskySolver_assemble);
+
+  // Numeric factorization, reusing the symbolic analysis
+  gttic_(SparseCholeskySolver_factorize);
+  factorization_.factorize(hessian_);
+  const Vector& D = factorization_.vectorD();
+  for (Eigen::Index col = 0; col < D.size(); ++col) {
+    if (!(D(col) > 0.0)) {
+      const size_t p = std::upper_bound(columnOffsets_.begin(),
+                                        columnOffsets_.end(), size_t(col)) -
+                       columnOffsets_.begin() - 1;
+      throw IndeterminantLinearSystemException(ordering_[p]);
+    }
+  }
+  gttoc_(SparseCholeskySolver_factorize);
+
+  gttic_(SparseCholeskySolver_solve);
+  const Vector x = factorization_.solve(rhs_);
+  VectorValues result;
+  for (size_t p = 0; p < ordering_.size(); ++p)
+    result.emplace(ordering_[p],
+                   x.segment(columnOffsets_[p],
+                             columnOffsets_[p + 1] - columnOffsets_[p]));
+  return result;
+}
+
+/* ************************************************************************* */
+VectorValues SparseCholeskySolver::solve(const GaussianFactorGraph& gfg,
+                                         const Ordering& ordering) {
+  if (!matches(gfg) || !ordering_.equals(ordering))
+    analyze(gfg, ordering);
+  return solveAnalyzed(gfg);
+}
+
+/* ************************************************************************* */
+VectorValues SparseCholeskySolver::solve(const GaussianFactorGraph& gfg,
+                                         Ordering::OrderingType orderingType) {
+  if (!matches(gfg))
+    analyze(gfg, Ordering::Create(orderingType, gfg));
+  return solveAnalyzed(gfg);
+}
+
+}  // namespace gtsam
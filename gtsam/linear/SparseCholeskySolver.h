@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SparseCholeskySolver.h
+ * @brief Sparse-matrix Cholesky solver for Gaussian factor graphs, reusing
+ * the symbolic analysis across solves with the same structure.
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/SparseEigen.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <Eigen/SparseCholesky>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Solves a GaussianFactorGraph by assembling the normal equations
+ * \f$ A^T A x = A^T b \f$ as a column-compressed (CSC) sparse matrix and
+ * factoring it with Eigen's simplicial LDL^T.
+ *
+ * The sparsity pattern, the scatter offsets of every factor and the symbolic
+ * analysis are computed once for a given graph structure (keys per factor,
+ * variable dimensions and ordering).  Subsequent calls with a graph of the same
+ * structure, e.g. successive linearizations in a nonlinear optimizer, only
+ * re-assemble the values and refactor numerically.
+ *
+ * This is the solver used for NonlinearOptimizerParams::CHOLMOD.  Constrained
+ * noise models are not supported.
+ */
+class GTSAM_EXPORT SparseCholeskySolver {
+ public:
+  typedef std::shared_ptr<SparseCholeskySolver> shared_ptr;
+
+  /// Default constructor, the structure is computed on the first solve
+  SparseCholeskySolver() {}
+
+  /**
+   * Solve with the given elimination ordering.
+   * @throw IndeterminantLinearSystemException if the system is not positive
+   * definite.
+   */
+  VectorValues solve(const GaussianFactorGraph& gfg, const Ordering& ordering);
+
+  /// Solve, computing an ordering of the given type when the structure changes
+  VectorValues solve(const GaussianFactorGraph& gfg,
+                     Ordering::OrderingType orderingType = Ordering::COLAMD);
+
+  /// Whether \c gfg has the same structure as the last solved graph
+  bool matches(const GaussianFactorGraph& gfg) const;
+
+  /**
+   * Compute the sparsity pattern, scatter offsets and symbolic analysis for
+   * the structure of \c gfg with the given ordering.
+   * @throw std::invalid_argument for constrained noise models, or if the
+   * ordering does not contain all keys.
+   */
+  void analyze(const GaussianFactorGraph& gfg, const Ordering& ordering);
+
+  /**
+   * Solve a graph with the analyzed structure, which is not checked, adding
+   * \c damping to the diagonal of the normal equations if it is non-empty.
+   * A null factor where the analyzed graph had one contributes nothing.
+   * The damping is indexed by the columns of the ordered variables.
+   * @throw IndeterminantLinearSystemException if the system is not positive
+   * definite.
+   */
+  VectorValues solveAnalyzed(const GaussianFactorGraph& gfg,
+                             const Vector& damping = Vector());
+
+  /// Number of times the structure and symbolic analysis were (re)computed
+  size_t nrAnalyses() const { return nrAnalyses_; }
+
+  /// The last assembled Hessian, lower triangle and diagonal blocks
+  const SparseEigen& hessian() const { return hessian_; }
+
+ private:
+  typedef Eigen::SimplicialLDLT<SparseEigen, Eigen::Lower,
+                                Eigen::NaturalOrdering<int> >
+      Factorization;
+
+  // Structure signature
+  std::vector<size_t> factorSizes_;   ///< number of keys per factor slot
+  std::vector<Key> factorKeys_;       ///< keys of all factors, concatenated
+  std::vector<size_t> factorDims_;    ///< dims of all factor keys, concatenated
+  Ordering ordering_;                 ///< elimination ordering
+
+  // Pattern
+  std::vector<size_t> columnOffsets_; ///< first column of each ordered variable
+  std::vector<size_t> factorPositions_; ///< ordered position of each factor key
+  std::vector<size_t> pairOffsets_;   ///< per factor, per lower block pair:
+                                      ///< offset of the block in its columns
+  SparseEigen hessian_;               ///< normal equations, fixed pattern
+  Vector rhs_;                        ///< A^T b
+  Factorization factorization_;       ///< reused symbolic analysis
+  size_t nrAnalyses_ = 0;
+};
+
+}  // namespace gtsam
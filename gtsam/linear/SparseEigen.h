@@ -35,7 +35,7 @@ namespace gtsam {
 typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> SparseEigen;
 
 /// Constructs an Eigen-format SparseMatrix of a GaussianFactorGraph
-SparseEigen sparseJacobianEigen(
+inline SparseEigen sparseJacobianEigen(
     const GaussianFactorGraph &gfg, const Ordering &ordering) {
   gttic_(SparseEigen_sparseJacobianEigen);
   // intermediate `entries` vector is kind of unavoidable due to how expensive
@@ -55,7 +55,7 @@ SparseEigen sparseJacobianEigen(
   return Ab;
 }
 
-SparseEigen sparseJacobianEigen(const GaussianFactorGraph &gfg) {
+inline SparseEigen sparseJacobianEigen(const GaussianFactorGraph &gfg) {
   gttic_(SparseEigen_sparseJacobianEigen_defaultOrdering);
   return sparseJacobianEigen(gfg, Ordering(gfg.keys()));
 }
@@ -113,6 +113,14 @@ namespace gtsam {
     return *this;
   }
 
+  /* ************************************************************************ */
+  size_t VectorValues::memoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& [key, value] : values_)
+      bytes += sizeof(Values::value_type) + value.size() * sizeof(double);
+    return bytes;
+  }
+
   /* ************************************************************************ */
   void VectorValues::setZero()
   {
@@ -129,6 +129,9 @@ namespace gtsam {
     /** Return the dimension of variable \c j. */
     size_t dim(Key j) const { return at(j).rows(); }
 
+    /** Bytes used by the map entries and the vectors they hold. */
+    size_t memoryUsage() const;
+
     /** Check whether a variable with key \c j exists. */
     bool exists(Key j) const { return find(j) != end(); }
 
@@ -0,0 +1,47 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file parallelFor.h
+ * @brief Parallel loop over an index range, internal to the linear solvers
+ */
+
+#pragma once
+
+#include <gtsam/base/types.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <cstddef>
+
+namespace gtsam {
+namespace internal {
+
+/// Run body(i) for i in [0, n), in parallel if TBB is available
+template <class BODY>
+void parallelFor(size_t n, const BODY &body) {
+#ifdef GTSAM_USE_TBB
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+    [&](const tbb::blocked_range<size_t> &range) {
+      for (size_t i = range.begin(); i != range.end(); ++i) body(i);
+    });
+#else
+  for (size_t i = 0; i < n; ++i) body(i);
+#endif
+}
+
+}  // namespace internal
+}  // namespace gtsam
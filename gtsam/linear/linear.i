@@ -686,6 +686,12 @@ virtual class BlockJacobiPreconditionerParameters : gtsam::PreconditionerParamet
   BlockJacobiPreconditionerParameters();
 };
 
+virtual class IncompleteCholeskyPreconditionerParameters : gtsam::PreconditionerParameters {
+  IncompleteCholeskyPreconditionerParameters();
+  double initialShift;
+  size_t maxShiftAttempts;
+};
+
 #include <gtsam/linear/PCGSolver.h>
 virtual class PCGSolverParameters : gtsam::ConjugateGradientParameters {
   PCGSolverParameters();
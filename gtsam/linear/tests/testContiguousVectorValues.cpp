@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testContiguousVectorValues.cpp
+ * @brief   Unit tests for ContiguousVectorValues
+ */
+
+#include <gtsam/base/Testable.h>
+#include <gtsam/linear/ContiguousVectorValues.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+VectorValues createValues() {
+  VectorValues values;
+  values.insert(5, Vector2(5, 6));
+  values.insert(0, Vector1(1));
+  values.insert(2, Vector3(2, 3, 4));
+  return values;
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(ContiguousVectorValues, layout) {
+  const ContiguousVectorValues actual(createValues());
+
+  // Blocks are stored in key order
+  EXPECT_LONGS_EQUAL(3, actual.size());
+  EXPECT_LONGS_EQUAL(6, actual.dim());
+  EXPECT(assert_equal((Vector(6) << 1, 2, 3, 4, 5, 6).finished(),
+                      actual.vector()));
+  EXPECT_LONGS_EQUAL(1, actual.layout()->offset(1));
+  EXPECT_LONGS_EQUAL(3, actual.layout()->dim(1));
+  EXPECT(assert_equal(Vector(Vector3(2, 3, 4)), Vector(actual.at(2))));
+  EXPECT(actual.exists(5));
+  EXPECT(!actual.exists(1));
+  CHECK_EXCEPTION(actual.at(1), std::out_of_range);
+
+  // Round trip
+  EXPECT(assert_equal(createValues(), actual.vectorValues()));
+
+  // Same structure as a Dims map
+  VectorValues::Dims dims;
+  dims[0] = 1;
+  dims[2] = 3;
+  dims[5] = 2;
+  EXPECT(ContiguousVectorValues::Layout(dims).equals(*actual.layout()));
+}
+
+/* ************************************************************************* */
+TEST(ContiguousVectorValues, operations) {
+  const VectorValues values = createValues();
+  const ContiguousVectorValues x(values);
+  const ContiguousVectorValues y(values.scale(2.0), x.layout());
+  EXPECT(x.layout() == y.layout());
+
+  EXPECT_DOUBLES_EQUAL(values.dot(values.scale(2.0)), x.dot(y), 1e-9);
+  EXPECT_DOUBLES_EQUAL(values.norm(), x.norm(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(values.squaredNorm(), x.squaredNorm(), 1e-9);
+  EXPECT(assert_equal(values.scale(3.0), (x + y).vectorValues()));
+  EXPECT(assert_equal(values.scale(-1.0), (x - y).vectorValues()));
+  EXPECT(assert_equal(values.scale(0.5), (0.5 * x).vectorValues()));
+
+  ContiguousVectorValues z = x;
+  z.axpy(-0.5, y);
+  EXPECT_DOUBLES_EQUAL(0.0, z.norm(), 1e-9);
+  z += x;
+  EXPECT(assert_equal(x, z));
+  z *= 4.0;
+  z -= y;
+  EXPECT(assert_equal(y, z));
+  z.at(2).setZero();
+  EXPECT_DOUBLES_EQUAL(1 * 2 + 5 * 10 + 6 * 12, x.dot(z), 1e-9);
+
+  // An independently built layout with the same structure is compatible
+  const ContiguousVectorValues w(values);
+  EXPECT(w.layout() != x.layout());
+  EXPECT_DOUBLES_EQUAL(x.squaredNorm(), x.dot(w), 1e-9);
+
+  // A different structure is not
+  VectorValues other = values;
+  other.insert(7, Vector1(1));
+  const ContiguousVectorValues v(other);
+  CHECK_EXCEPTION(x.dot(v), std::invalid_argument);
+  CHECK_EXCEPTION(ContiguousVectorValues(other, x.layout()),
+                  std::invalid_argument);
+  EXPECT(!x.equals(v));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -127,6 +127,33 @@ TEST( GaussianBayesTree, optimizeMultiFrontal )
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianBayesTree, refine) {
+  // A chain of 2D variables with loop closures
+  GaussianFactorGraph graph;
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 0.1);
+  graph.add(0, I_2x2, Vector2(0.1, 0.2), model);
+  for (size_t i = 1; i < 10; ++i)
+    graph.add(i - 1, -I_2x2, i, (Matrix2() << 1.0, 0.1, -0.2, 1.0).finished(),
+              Vector2(1.0 / i, 0.3), model);
+  graph.add(0, -I_2x2, 9, I_2x2, Vector2(2.0, -1.0), model);
+  graph.add(3, -I_2x2, 7, I_2x2, Vector2(1.0, 0.5), model);
+  const Ordering ordering = Ordering::Colamd(graph);
+
+  // With an exact factorization, backsubstitution solves the normal equations
+  const GaussianBayesTree exact = *graph.eliminateMultifrontal(ordering);
+  const VectorValues expected = exact.optimize();
+  EXPECT(assert_equal(expected, exact.backSubstitute(exact.backSubstituteTranspose(
+                                    -1.0 * graph.gradientAtZero())), 1e-9));
+
+  // Refinement recovers the double precision solution
+  const GaussianBayesTree single =
+      *graph.eliminateMultifrontal(ordering, EliminateCholeskySinglePrecision);
+  const VectorValues initial = single.optimize();
+  EXPECT(assert_equal(expected, initial, 1e-3));
+  EXPECT(assert_equal(expected, single.refine(graph, initial), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(GaussianBayesTree, complicatedMarginal) {
   // Create the conditionals to go in the BayesTree
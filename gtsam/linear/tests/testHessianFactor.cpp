@@ -476,6 +476,23 @@ TEST(HessianFactor, combine) {
 
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, combineFixedSizeBlocks) {
+  // Block dimensions with (6, 15, 2) and without (4) a fixed-size kernel
+  const Matrix A0 = Matrix::Random(5, 6), A1 = Matrix::Random(5, 15),
+               A2 = Matrix::Random(5, 4), A3 = Matrix::Random(5, 2);
+  const Vector b = Vector::Random(5);
+  const auto jacobian = std::make_shared<JacobianFactor>(
+      std::vector<std::pair<Key, Matrix>>{{0, A0}, {1, A1}, {2, A2}, {3, A3}}, b);
+  const auto hessian = std::make_shared<HessianFactor>(*jacobian);
+  const Matrix Ab = jacobian->augmentedJacobian();
+  EXPECT(assert_equal(Matrix(Ab.transpose() * Ab), hessian->augmentedInformation(), 1e-9));
+
+  // Scatter both into the same information matrix
+  const HessianFactor actual(GaussianFactorGraph{jacobian, hessian});
+  EXPECT(assert_equal(Matrix(2 * Ab.transpose() * Ab), actual.augmentedInformation(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(HessianFactor, gradientAtZero)
 {
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSparseCholeskySolver.cpp
+ * @brief   Unit tests for the sparse normal-equations Cholesky solver
+ */
+
+#include <gtsam/linear/SparseCholeskySolver.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+// A chain x0 - x1 - x2 with a prior on x0 and an extra loop x0 - x2
+GaussianFactorGraph createChain(double scale) {
+  GaussianFactorGraph gfg;
+  SharedDiagonal model2 = noiseModel::Isotropic::Sigma(2, 0.5);
+  gfg.add(0, scale * I_2x2, Vector2(1, 2), model2);
+  gfg.add(0, (Matrix(2, 2) << 1, 2, 0, 1).finished(), 1,
+          (Matrix(2, 3) << 1, 0, 1, 0, 1, 1).finished(), Vector2(3, 4), model2);
+  gfg.add(1, scale * Matrix::Identity(3, 3), 2,
+          (Matrix(3, 2) << 1, 0, 0, 1, 1, 1).finished(), Vector3(5, 6, 7),
+          noiseModel::Unit::Create(3));
+  gfg.add(2, I_2x2, 0, -scale * I_2x2, Vector2(8, 9), model2);
+  // Hessian factors are assembled through their information matrix as well
+  gfg.add(HessianFactor(JacobianFactor(2, 2.0 * I_2x2, Vector2(1, 1))));
+  return gfg;
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(SparseCholeskySolver, solve) {
+  const GaussianFactorGraph gfg = createChain(1.0);
+  const Ordering ordering{2, 0, 1};
+
+  SparseCholeskySolver solver;
+  EXPECT(!solver.matches(gfg));
+  const VectorValues actual = solver.solve(gfg, ordering);
+  EXPECT(assert_equal(gfg.optimize(ordering), actual, 1e-9));
+  EXPECT_LONGS_EQUAL(1, solver.nrAnalyses());
+  EXPECT(solver.matches(gfg));
+
+  // The assembled lower triangle agrees with the dense Hessian
+  const Matrix expectedHessian = gfg.hessian(ordering).first;
+  const Matrix actualLower = Matrix(solver.hessian()).triangularView<Eigen::Lower>();
+  EXPECT(assert_equal(Matrix(expectedHessian.triangularView<Eigen::Lower>()),
+                      actualLower, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(SparseCholeskySolver, reuseStructure) {
+  SparseCholeskySolver solver;
+  const GaussianFactorGraph gfg1 = createChain(1.0);
+  EXPECT(assert_equal(gfg1.optimize(), solver.solve(gfg1), 1e-9));
+
+  // Same structure, different numbers: only refactor numerically
+  const GaussianFactorGraph gfg2 = createChain(3.0);
+  EXPECT(solver.matches(gfg2));
+  EXPECT(assert_equal(gfg2.optimize(), solver.solve(gfg2), 1e-9));
+  EXPECT_LONGS_EQUAL(1, solver.nrAnalyses());
+
+  // A new factor changes the structure
+  GaussianFactorGraph gfg3 = gfg2;
+  gfg3.add(1, Matrix::Identity(3, 3), Vector3(1, 0, 0),
+           noiseModel::Unit::Create(3));
+  EXPECT(!solver.matches(gfg3));
+  EXPECT(assert_equal(gfg3.optimize(), solver.solve(gfg3), 1e-9));
+  EXPECT_LONGS_EQUAL(2, solver.nrAnalyses());
+}
+
+/* ************************************************************************* */
+TEST(SparseCholeskySolver, indeterminant) {
+  // x1 is not constrained
+  GaussianFactorGraph gfg;
+  gfg.add(0, I_2x2, Vector2(1, 2), noiseModel::Unit::Create(2));
+  gfg.add(0, I_2x2, 1, Matrix::Zero(2, 2), Vector2(1, 2),
+          noiseModel::Unit::Create(2));
+  SparseCholeskySolver solver;
+  CHECK_EXCEPTION(solver.solve(gfg, Ordering{0, 1}),
+                  IndeterminantLinearSystemException);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AsyncISAM2.cpp
+ * @brief   ISAM2 front end that applies updates on a background thread
+ */
+
+#include <gtsam/nonlinear/AsyncISAM2.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+AsyncISAM2::AsyncISAM2(const ISAM2Params& params)
+    : isam_(params), worker_(&AsyncISAM2::run, this) {}
+
+/* ************************************************************************* */
+AsyncISAM2::~AsyncISAM2() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  pending_.notify_one();
+  worker_.join();
+}
+
+/* ************************************************************************* */
+std::future<ISAM2Result> AsyncISAM2::update(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const FactorIndices& removeFactorIndices) {
+  ISAM2UpdateParams params;
+  params.removeFactorIndices = removeFactorIndices;
+  return update(newFactors, newTheta, params);
+}
+
+/* ************************************************************************* */
+std::future<ISAM2Result> AsyncISAM2::update(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const ISAM2UpdateParams& updateParams) {
+  std::future<ISAM2Result> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(Request{newFactors, newTheta, updateParams, {}});
+    result = queue_.back().result.get_future();
+  }
+  pending_.notify_one();
+  return result;
+}
+
+/* ************************************************************************* */
+AsyncISAM2::Snapshot AsyncISAM2::estimate() const {
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+  return estimate_.load();
+#else
+  std::lock_guard<std::mutex> lock(estimateMutex_);
+  return estimate_;
+#endif
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::publish(Snapshot estimate) {
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+  estimate_.store(std::move(estimate));
+#else
+  // Swap under the lock, the old snapshot is released after unlocking
+  std::lock_guard<std::mutex> lock(estimateMutex_);
+  estimate_.swap(estimate);
+#endif
+}
+
+/* ************************************************************************* */
+size_t AsyncISAM2::nrCompletedUpdates() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return nrCompleted_;
+}
+
+/* ************************************************************************* */
+size_t AsyncISAM2::nrPendingUpdates() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size() + (busy_ ? 1 : 0);
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::waitForUpdates() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+/* ************************************************************************* */
+AsyncISAM2::PauseWorker::PauseWorker(const AsyncISAM2& async) : async_(async) {
+  std::unique_lock<std::mutex> lock(async_.mutex_);
+  async_.idle_.wait(lock, [this] {
+    return async_.queue_.empty() && !async_.busy_ && !async_.paused_;
+  });
+  async_.paused_ = true;
+}
+
+/* ************************************************************************* */
+AsyncISAM2::PauseWorker::~PauseWorker() {
+  {
+    std::lock_guard<std::mutex> lock(async_.mutex_);
+    async_.paused_ = false;
+  }
+  async_.pending_.notify_one();
+  async_.idle_.notify_all();
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    pending_.wait(lock,
+                  [this] { return !paused_ && (stop_ || !queue_.empty()); });
+    // Pending requests are still applied when stopping
+    if (queue_.empty())
+      return;
+    Request request = std::move(queue_.front());
+    queue_.pop_front();
+    busy_ = true;
+    lock.unlock();
+
+    // The update and the estimate run without holding the lock, so that
+    // callers can keep queueing and reading while the worker is busy.
+    try {
+      gttic_(AsyncISAM2_update);
+      ISAM2Result result = isam_.update(request.newFactors, request.newTheta,
+                                        request.updateParams);
+      gttoc_(AsyncISAM2_update);
+      gttic_(AsyncISAM2_publish);
+      publish(std::make_shared<const Values>(isam_.calculateEstimate()));
+      gttoc_(AsyncISAM2_publish);
+      request.result.set_value(std::move(result));
+    } catch (...) {
+      request.result.set_exception(std::current_exception());
+    }
+
+    lock.lock();
+    busy_ = false;
+    ++nrCompleted_;
+    idle_.notify_all();
+  }
+}
+
+}  // namespace gtsam
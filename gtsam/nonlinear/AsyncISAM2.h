@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AsyncISAM2.h
+ * @brief   ISAM2 front end that applies updates on a background thread
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gtsam {
+
+/**
+ * Asynchronous front end to ISAM2.
+ *
+ * update() only queues the new factors and values and returns immediately; a
+ * worker thread owned by this object applies the queued updates to an internal
+ * ISAM2 instance in the order they were submitted.  After every update the
+ * worker computes the full estimate and publishes it as an immutable Values
+ * snapshot.  estimate() returns the latest snapshot without waiting for a
+ * running update, so readers such as a perception thread never stall on a
+ * long relinearization or loop closure.
+ *
+ * The ISAM2Result of every update, or the exception it threw, is delivered
+ * through the std::future returned by update().
+ */
+class GTSAM_EXPORT AsyncISAM2 {
+ public:
+  typedef std::shared_ptr<const Values> Snapshot;
+
+  /// Create the ISAM2 instance and start the worker thread
+  explicit AsyncISAM2(const ISAM2Params& params = ISAM2Params());
+
+  /// Apply all pending updates, then stop the worker thread
+  ~AsyncISAM2();
+
+  AsyncISAM2(const AsyncISAM2&) = delete;
+  AsyncISAM2& operator=(const AsyncISAM2&) = delete;
+
+  /// @name Standard Interface
+  /// @{
+
+  /**
+   * Queue new factors and values for the worker thread, see ISAM2::update for
+   * the meaning of the arguments.  Returns immediately.
+   * @return a future holding the result of the update once it was applied
+   */
+  std::future<ISAM2Result> update(
+      const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+      const Values& newTheta = Values(),
+      const FactorIndices& removeFactorIndices = FactorIndices());
+
+  /// Queue an update with additional parameters, see ISAM2::update
+  std::future<ISAM2Result> update(const NonlinearFactorGraph& newFactors,
+                                  const Values& newTheta,
+                                  const ISAM2UpdateParams& updateParams);
+
+  /**
+   * The estimate after the last applied update.  Never waits for a running
+   * update; the returned snapshot stays valid and unchanged for as long as the
+   * caller holds it.  Empty before the first update completed.
+   *
+   * With C++20 the snapshot pointer is a std::atomic<std::shared_ptr>;
+   * otherwise it is guarded by a mutex that is only held to copy the pointer.
+   * Neither is lock-free in libstdc++, but no lock is ever held for longer
+   * than a reference count update.
+   */
+  Snapshot estimate() const;
+
+  /// Number of updates applied so far, including the ones that failed
+  size_t nrCompletedUpdates() const;
+
+  /// Number of updates queued or being applied
+  size_t nrPendingUpdates() const;
+
+  /// Block until all updates queued so far have been applied
+  void waitForUpdates() const;
+
+  /**
+   * Run \c function on the internal ISAM2 instance, e.g. to compute marginal
+   * covariances, after all updates queued so far have been applied.  The
+   * worker thread is paused while \c function executes, but update() and
+   * estimate() can still be called; calls to withISAM2 run one at a time.
+   */
+  template <typename FUNCTION>
+  auto withISAM2(FUNCTION&& function) const
+      -> decltype(function(std::declval<const ISAM2&>())) {
+    const PauseWorker pause(*this);
+    return function(static_cast<const ISAM2&>(isam_));
+  }
+
+  /// @}
+
+ private:
+  /// A queued call to ISAM2::update
+  struct Request {
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+    ISAM2UpdateParams updateParams;
+    std::promise<ISAM2Result> result;
+  };
+
+  /// Waits until the worker is idle and keeps it paused while in scope
+  class GTSAM_EXPORT PauseWorker {
+   public:
+    explicit PauseWorker(const AsyncISAM2& async);
+    ~PauseWorker();
+
+   private:
+    const AsyncISAM2& async_;
+  };
+
+  /// Worker thread main loop
+  void run();
+
+  /// Replace the published estimate
+  void publish(Snapshot estimate);
+
+  ISAM2 isam_;  ///< only used by the worker, or by withISAM2 when paused
+
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+  std::atomic<Snapshot> estimate_;  ///< latest estimate
+#else
+  mutable std::mutex estimateMutex_;  ///< only guards estimate_
+  Snapshot estimate_;  ///< latest estimate
+#endif
+
+  mutable std::mutex mutex_;  ///< guards the members below
+  mutable std::condition_variable pending_;  ///< signaled when a request is queued
+  mutable std::condition_variable idle_;  ///< signaled when a request is done
+  std::deque<Request> queue_;
+  bool busy_ = false;  ///< whether the worker is applying a request
+  mutable bool paused_ = false;  ///< whether withISAM2 is running
+  bool stop_ = false;
+  size_t nrCompleted_ = 0;
+
+  std::thread worker_;  ///< started last, after all members are initialized
+};
+
+}  // namespace gtsam
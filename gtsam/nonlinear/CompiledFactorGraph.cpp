@@ -0,0 +1,124 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompiledFactorGraph.cpp
+ * @brief   Nonlinear factor graph with precomputed structure
+ */
+
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/timing.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+CompiledFactorGraph::CompiledFactorGraph(const NonlinearFactorGraph& graph,
+                                         const Values& values,
+                                         const Ordering& ordering)
+    : graph_(graph), ordering_(ordering) {
+  compile(values);
+}
+
+/* ************************************************************************* */
+CompiledFactorGraph::CompiledFactorGraph(const NonlinearFactorGraph& graph,
+                                         const Values& values)
+    : graph_(graph), ordering_(Ordering::Colamd(graph)) {
+  compile(values);
+}
+
+/* ************************************************************************* */
+void CompiledFactorGraph::compile(const Values& values) {
+  gttic_(CompiledFactorGraph_compile);
+
+  // Dense variable indices and column offsets, in ordering order
+  columnOffsets_.assign(1, 0);
+  for (size_t i = 0; i < ordering_.size(); ++i) {
+    if (!indices_.emplace(ordering_[i], i).second)
+      throw std::invalid_argument(
+          "CompiledFactorGraph: the ordering contains a key twice");
+    columnOffsets_.push_back(columnOffsets_.back() +
+                             values.at(ordering_[i]).dim());
+  }
+
+  // Structure of the linearization, built from the keys rather than by
+  // linearizing, so that factors inactive at values are included
+  GaussianFactorGraph structure;
+  structure.reserve(graph_.size());
+  for (const auto& factor : graph_) {
+    if (!factor) {
+      structure.push_back(GaussianFactor::shared_ptr());
+      continue;
+    }
+    const auto noiseModelFactor =
+        std::dynamic_pointer_cast<NoiseModelFactor>(factor);
+    if (noiseModelFactor && noiseModelFactor->noiseModel() &&
+        noiseModelFactor->noiseModel()->isConstrained())
+      throw std::invalid_argument(
+          "CompiledFactorGraph: constrained noise models are not supported");
+    std::vector<std::pair<Key, Matrix> > terms;
+    for (Key key : factor->keys())
+      terms.emplace_back(key, Matrix::Zero(1, values.at(key).dim()));
+    structure.emplace_shared<JacobianFactor>(terms, Vector::Zero(1));
+  }
+
+  // Sparsity pattern, Hessian block destinations and symbolic factorization
+  solver_.analyze(structure, ordering_);
+  if (size_t(solver_.hessian().rows()) != dim())
+    throw std::invalid_argument(
+        "CompiledFactorGraph: every variable in the ordering must be involved "
+        "in a factor");
+}
+
+/* ************************************************************************* */
+size_t CompiledFactorGraph::index(Key j) const {
+  auto it = indices_.find(j);
+  if (it == indices_.end())
+    throw std::out_of_range("CompiledFactorGraph: requested variable '" +
+                            DefaultKeyFormatter(j) +
+                            "' is not in the ordering");
+  return it->second;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr CompiledFactorGraph::linearize(
+    const Values& values) const {
+  return graph_.linearize(values, arena_);
+}
+
+/* ************************************************************************* */
+VectorValues CompiledFactorGraph::solve(const GaussianFactorGraph& linear,
+                                        const Vector& damping) const {
+  if (linear.size() != graph_.size())
+    throw std::invalid_argument(
+        "CompiledFactorGraph::solve: the linear graph does not have one slot "
+        "per factor of the compiled graph");
+  return solver_.solveAnalyzed(linear, damping);
+}
+
+/* ************************************************************************* */
+Vector CompiledFactorGraph::damping(
+    double lambda, const VectorValues& sqrtHessianDiagonal) const {
+  if (sqrtHessianDiagonal.size() == 0)
+    return Vector::Constant(dim(), lambda);
+  Vector result = Vector::Zero(dim());
+  for (const auto& [key, sqrtDiagonal] : sqrtHessianDiagonal) {
+    const size_t i = index(key);
+    result.segment(columnOffsets_[i], variableDim(i)) =
+        lambda * sqrtDiagonal.array().square();
+  }
+  return result;
+}
+
+}  // namespace gtsam
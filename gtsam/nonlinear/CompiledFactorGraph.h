@@ -0,0 +1,135 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompiledFactorGraph.h
+ * @brief   Nonlinear factor graph with precomputed structure, for repeated
+ *          optimization of a graph whose structure does not change
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/linear/SparseCholeskySolver.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <memory>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A NonlinearFactorGraph frozen together with an elimination ordering.
+ *
+ * On construction, every variable gets a dense index in ordering order and a
+ * column offset, and the sparsity pattern and symbolic factorization of the
+ * normal equations are analyzed once from the keys of all factors, including
+ * the destination of every Hessian block.  Afterwards linearize() reuses the
+ * Jacobian storage of factors that support it, and solve() scatters each
+ * factor's information into the precomputed block destinations and only
+ * refactors numerically.  Factors that are inactive in a linearization
+ * contribute nothing to the normal equations.
+ *
+ * GaussNewtonOptimizer and LevenbergMarquardtOptimizer can be constructed from
+ * a CompiledFactorGraph, DoglegOptimizer uses it for linearization.  The graph
+ * must not be modified afterwards.  Constrained noise models are not
+ * supported.
+ */
+class GTSAM_EXPORT CompiledFactorGraph {
+ public:
+  typedef std::shared_ptr<CompiledFactorGraph> shared_ptr;
+
+  /**
+   * Precompute the structure of \c graph, with the variable dimensions of
+   * \c values and the given elimination ordering.
+   * @throw std::invalid_argument if the ordering does not contain all keys of
+   * the graph, or for constrained noise models.
+   */
+  CompiledFactorGraph(const NonlinearFactorGraph& graph, const Values& values,
+                      const Ordering& ordering);
+
+  /// Compile with a COLAMD ordering
+  CompiledFactorGraph(const NonlinearFactorGraph& graph, const Values& values);
+
+  /// @name Structure
+  /// @{
+
+  /// The nonlinear factor graph
+  const NonlinearFactorGraph& graph() const { return graph_; }
+
+  /// The elimination ordering
+  const Ordering& ordering() const { return ordering_; }
+
+  /// Number of variables
+  size_t nrVariables() const { return ordering_.size(); }
+
+  /// Total dimension of all variables
+  size_t dim() const { return columnOffsets_.back(); }
+
+  /// Dense index of key \c j, its position in the ordering
+  size_t index(Key j) const;
+
+  /// First column of the variable with dense index \c i
+  size_t columnOffset(size_t i) const { return columnOffsets_[i]; }
+
+  /// Dimension of the variable with dense index \c i
+  size_t variableDim(size_t i) const {
+    return columnOffsets_[i + 1] - columnOffsets_[i];
+  }
+
+  /// @}
+  /// @name Evaluation
+  /// @{
+
+  /// Total error of the graph at \c values
+  double error(const Values& values) const { return graph_.error(values); }
+
+  /**
+   * Linearize at \c values, overwriting the Jacobians of the previous
+   * linearization in place once the caller has released it.
+   */
+  GaussianFactorGraph::shared_ptr linearize(const Values& values) const;
+
+  /**
+   * Solve a linearization of this graph with the precomputed structure,
+   * optionally adding \c damping to the diagonal of the normal equations.
+   * \c linear must come from linearize(), or otherwise have the keys of
+   * graph() per factor; its structure is not checked.  Null factors, from
+   * inactive nonlinear factors, are skipped.
+   * @param damping one entry per column, see columnOffset(), or empty.
+   * @throw IndeterminantLinearSystemException if the system is singular.
+   */
+  VectorValues solve(const GaussianFactorGraph& linear,
+                     const Vector& damping = Vector()) const;
+
+  /**
+   * Levenberg-Marquardt damping \f$ \lambda \f$ for every column, or
+   * \f$ \lambda \, \mathrm{diag} \f$ given the square root of the damped
+   * Hessian diagonal, as used by LevenbergMarquardtParams::diagonalDamping.
+   */
+  Vector damping(double lambda,
+                 const VectorValues& sqrtHessianDiagonal = VectorValues()) const;
+
+  /// @}
+
+ private:
+  void compile(const Values& values);
+
+  NonlinearFactorGraph graph_;
+  Ordering ordering_;
+  FastMap<Key, size_t> indices_;        ///< key to dense index
+  std::vector<size_t> columnOffsets_;   ///< nrVariables() + 1 entries
+
+  mutable LinearizationArena arena_;           ///< reused Jacobian storage
+  mutable SparseCholeskySolver solver_;        ///< analyzed normal equations
+};
+
+}  // namespace gtsam
@@ -19,6 +19,7 @@
 #include <gtsam/nonlinear/DoglegOptimizer.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <gtsam/nonlinear/internal/NonlinearOptimizerState.h>
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
@@ -76,6 +77,17 @@ DoglegOptimizer::DoglegOptimizer(const NonlinearFactorGraph& graph, const Values
   params_.ordering = ordering;
 }
 
+DoglegOptimizer::DoglegOptimizer(const std::shared_ptr<CompiledFactorGraph>& compiled,
+                                 const Values& initialValues, const DoglegParams& params)
+    : NonlinearOptimizer(compiled->graph(),
+                         std::unique_ptr<State>(new State(initialValues,
+                                                          compiled->error(initialValues),
+                                                          params.deltaInitial))),
+      params_(params) {
+  params_.ordering = compiled->ordering();
+  compiled_ = compiled;
+}
+
 double DoglegOptimizer::getDelta() const {
   return static_cast<const State*>(state_.get())->delta;
 }
@@ -84,7 +96,7 @@ double DoglegOptimizer::getDelta() const {
 GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = linearizeGraph(state_->values);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -96,6 +108,9 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
     GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
     VectorValues dx_u = bt.optimizeGradientSearch();
     VectorValues dx_n = bt.optimize();
+    if (params_.linearSolverType == NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY_MIXED &&
+        !hasConstraints(*linear))
+      dx_n = bt.refine(*linear, dx_n);
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
       dx_u, dx_n, bt, graph_, state_->values, state_->error, dlVerbose);
   }
@@ -97,6 +97,16 @@ public:
   DoglegOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
                   const Ordering& ordering);
 
+  /** Optimize a compiled graph with its ordering.  The compiled graph is used
+   * for linearization; the dogleg step still eliminates the linear graph.
+   * @param compiled The compiled graph to optimize
+   * @param initialValues The initial variable assignments
+   * @param params The optimization parameters
+   */
+  DoglegOptimizer(const std::shared_ptr<CompiledFactorGraph>& compiled,
+                  const Values& initialValues,
+                  const DoglegParams& params = DoglegParams());
+
   /// @}
 
   /// @name Advanced interface
@@ -127,27 +127,24 @@ protected:
     // Create a writeable JacobianFactor in advance
     std::shared_ptr<JacobianFactor> factor(
         new JacobianFactor(keys_, dims_, Dim, noiseModel));
+    linearizeInto(x, factor->matrixObject());
+    return factor;
+  }
 
-    // Wrap keys and VerticalBlockMatrix into structure passed to expression_
-    VerticalBlockMatrix& Ab = factor->matrixObject();
-    internal::JacobianMap jacobianMap(keys_, Ab);
-
-    // Zero out Jacobian so we can simply add to it
-    Ab.matrix().setZero();
-
-    // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
-
-    // Evaluate error and set RHS vector b
-    Ab(size()).col(0) = traits<T>::Local(value, measured_);
-
-    // Whiten the corresponding system, Ab already contains RHS
-    if (noiseModel_) {
-      Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
-      noiseModel_->WhitenSystem(Ab.matrix(), b);
+  /// Linearize into a JacobianFactor created by linearize() for this factor
+  bool linearizeInPlace(const Values& x, GaussianFactor& factor) const override {
+    auto jacobian = dynamic_cast<JacobianFactor*>(&factor);
+    const bool constrained = noiseModel_ && noiseModel_->isConstrained();
+    if (!jacobian || jacobian->keys() != keys_ ||
+        int(jacobian->rows()) != Dim ||
+        bool(jacobian->get_model()) != constrained || !active(x))
+      return false;
+    for (size_t j = 0; j < size(); ++j) {
+      if (jacobian->getDim(jacobian->begin() + j) != dims_[j])
+        return false;
     }
-
-    return factor;
+    linearizeInto(x, jacobian->matrixObject());
+    return true;
   }
 
   /// @return a deep copy of this factor
@@ -160,6 +157,27 @@ protected:
  ExpressionFactor() {}
  /// Default constructor, for serialization
 
+ /// Write the whitened Jacobians and right-hand side into Ab
+ void linearizeInto(const Values& x, VerticalBlockMatrix& Ab) const {
+   // Wrap keys and VerticalBlockMatrix into structure passed to expression_
+   internal::JacobianMap jacobianMap(keys_, Ab);
+
+   // Zero out Jacobian so we can simply add to it
+   Ab.matrix().setZero();
+
+   // Get value and Jacobians, writing directly into JacobianFactor
+   T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+
+   // Evaluate error and set RHS vector b
+   Ab(size()).col(0) = traits<T>::Local(value, measured_);
+
+   // Whiten the corresponding system, Ab already contains RHS
+   if (noiseModel_) {
+     Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
+     noiseModel_->WhitenSystem(Ab.matrix(), b);
+   }
+ }
+
  /// Constructor for serializable derived classes
  ExpressionFactor(const SharedNoiseModel& noiseModel, const T& measurement)
      : NoiseModelFactor(noiseModel), measured_(measurement) {
@@ -18,6 +18,7 @@
 
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/nonlinear/internal/NonlinearOptimizerState.h>
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -40,18 +41,30 @@ GaussNewtonOptimizer::GaussNewtonOptimizer(const NonlinearFactorGraph& graph,
   params_.ordering = ordering;
 }
 
+GaussNewtonOptimizer::GaussNewtonOptimizer(
+    const std::shared_ptr<CompiledFactorGraph>& compiled,
+    const Values& initialValues, const GaussNewtonParams& params)
+    : NonlinearOptimizer(compiled->graph(),
+                         std::unique_ptr<State>(new State(
+                             initialValues, compiled->error(initialValues)))),
+      params_(params) {
+  params_.ordering = compiled->ordering();
+  compiled_ = compiled;
+}
+
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
   gttic(GaussNewtonOptimizer_Iterate);
 
   // Linearize graph
   gttic(GaussNewtonOptimizer_Linearize);
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = linearizeGraph(state_->values);
   gttoc(GaussNewtonOptimizer_Linearize);
 
   // Solve Factor Graph
   gttic(GaussNewtonOptimizer_Solve);
-  const VectorValues delta = solve(*linear, params_);
+  const VectorValues delta =
+      compiled_ ? compiled_->solve(*linear) : solve(*linear, params_);
   gttoc(GaussNewtonOptimizer_Solve);
 
   // Maybe show output
@@ -64,6 +64,17 @@ public:
    */
   GaussNewtonOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
                        const Ordering& ordering);
+
+  /** Optimize a compiled graph with its ordering.  The normal equations are
+   * solved with the precomputed structure of the compiled graph, regardless of
+   * params.linearSolverType.
+   * @param compiled The compiled graph to optimize
+   * @param initialValues The initial variable assignments
+   * @param params The optimization parameters
+   */
+  GaussNewtonOptimizer(const std::shared_ptr<CompiledFactorGraph>& compiled,
+                       const Values& initialValues,
+                       const GaussNewtonParams& params = GaussNewtonParams());
   /// @}
 
   /// @name Advanced interface
@@ -274,6 +274,7 @@ class GncOptimizer {
   double initializeMu() const {
 
     double mu_init = 0.0;
+    const Vector errors = nfg_.factorErrors(state_);
     // initialize mu to the value specified in Remark 5 in GNC paper.
     switch (params_.lossType) {
       case GncLossType::GM:
@@ -282,7 +283,7 @@ class GncOptimizer {
          */
         for (size_t k = 0; k < nfg_.size(); k++) {
           if (nfg_[k]) {
-            mu_init = std::max(mu_init, 2 * nfg_[k]->error(state_) / barcSq_[k]);
+            mu_init = std::max(mu_init, 2 * errors[k] / barcSq_[k]);
           }
         }
         return mu_init;  // initial mu
@@ -296,7 +297,7 @@ class GncOptimizer {
         mu_init = std::numeric_limits<double>::infinity();
         for (size_t k = 0; k < nfg_.size(); k++) {
           if (nfg_[k]) {
-            double rk = nfg_[k]->error(state_);
+            double rk = errors[k];
             mu_init = (2 * rk - barcSq_[k]) > 0 ? // if positive, update mu, otherwise keep same
                 std::min(mu_init, barcSq_[k] / (2 * rk - barcSq_[k]) ) : mu_init;
           }
@@ -433,17 +434,20 @@ class GncOptimizer {
                    params_.knownOutliers.begin(), params_.knownOutliers.end(),
                    std::inserter(knownWeights, knownWeights.begin()));
 
-    std::vector<size_t> unknownWeights;
+    FactorIndices unknownWeights;
     std::set_difference(allWeights.begin(), allWeights.end(),
                         knownWeights.begin(), knownWeights.end(),
                         std::inserter(unknownWeights, unknownWeights.begin()));
 
+    // evaluate the factors with unknown weights at once, in parallel when using TBB
+    const Vector errors = nfg_.factorErrors(currentEstimate, unknownWeights);
+
     // update weights of known inlier/outlier measurements
     switch (params_.lossType) {
       case GncLossType::GM: {  // use eq (12) in GNC paper
         for (size_t k : unknownWeights) {
           if (nfg_[k]) {
-            double u2_k = nfg_[k]->error(currentEstimate);  // squared (and whitened) residual
+            double u2_k = errors[k];  // squared (and whitened) residual
             weights[k] = std::pow(
                 (mu * barcSq_[k]) / (u2_k + mu * barcSq_[k]), 2);
           }
@@ -453,7 +457,7 @@ class GncOptimizer {
       case GncLossType::TLS: {  // use eq (14) in GNC paper
         for (size_t k : unknownWeights) {
           if (nfg_[k]) {
-            double u2_k = nfg_[k]->error(currentEstimate);  // squared (and whitened) residual
+            double u2_k = errors[k];  // squared (and whitened) residual
             double upperbound = (mu + 1) / mu * barcSq_[k];
             double lowerbound = mu / (mu + 1) * barcSq_[k];
             weights[k] = std::sqrt(barcSq_[k] * mu * (mu + 1) / u2_k) - mu;
@@ -29,8 +29,10 @@
 #include <gtsam/linear/GaussianEliminationTree.h>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 
@@ -58,8 +60,10 @@ class ISAM2JunctionTree
   typedef ISAM2JunctionTree This;
   typedef std::shared_ptr<This> shared_ptr;
 
-  explicit ISAM2JunctionTree(const GaussianEliminationTree& eliminationTree)
-      : Base(eliminationTree) {}
+  explicit ISAM2JunctionTree(
+      const GaussianEliminationTree& eliminationTree,
+      const AmalgamationParams& amalgamation = AmalgamationParams())
+      : Base(eliminationTree, amalgamation) {}
 };
 
 /* ************************************************************************* */
@@ -76,12 +80,14 @@ struct GTSAM_EXPORT DeltaImpl {
   };
 
   /**
-   * Update the Newton's method step point, using wildfire
+   * Update the Newton's method step point, using wildfire.  If \c changedKeys
+   * is given, the variables whose delta changed are added to it.
    */
   static size_t UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
                                        const KeySet& replacedKeys,
                                        double wildfireThreshold,
-                                       VectorValues* delta);
+                                       VectorValues* delta,
+                                       KeySet* changedKeys = nullptr);
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -366,11 +372,10 @@ struct GTSAM_EXPORT UpdateImpl {
     return relinKeys;
   }
 
-  // Mark keys in \Delta above threshold \beta:
+  // Find keys in \Delta above threshold \beta:
   KeySet gatherRelinearizeKeys(const ISAM2::Roots& roots,
                                const VectorValues& delta,
-                               const KeySet& fixedVariables,
-                               KeySet* markedKeys) const {
+                               const KeySet& fixedVariables) const {
     gttic(gatherRelinearizeKeys);
     // J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
     KeySet relinKeys =
@@ -390,12 +395,63 @@ struct GTSAM_EXPORT UpdateImpl {
         relinKeys.erase(key);
       }
     }
-
-    // Add the variables being relinearized to the marked keys
-    markedKeys->insert(relinKeys.begin(), relinKeys.end());
     return relinKeys;
   }
 
+  // Keep the keys in relinKeys with the largest deltas, as long as the
+  // variables re-eliminated for them and for the marked keys are at most
+  // maxReeliminated, and move the others to deferredKeys.  The re-eliminated
+  // variables are estimated as the frontals of the cliques containing a key
+  // and of their ancestors.
+  static void DeferRelinearization(const ISAM2::Nodes& nodes,
+                                   const VectorValues& delta,
+                                   size_t maxReeliminated,
+                                   const KeySet& markedKeys, KeySet* relinKeys,
+                                   KeySet* deferredKeys) {
+    gttic(DeferRelinearization);
+    std::unordered_set<const ISAM2Clique*> removed;
+    size_t nrReeliminated = 0;
+    // Cliques from that of key to the first one already removed, new keys
+    // have no clique yet
+    auto pathToRemoved = [&](Key key) {
+      std::vector<const ISAM2Clique*> path;
+      const auto node = nodes.find(key);
+      if (node == nodes.end()) return path;
+      for (ISAM2::sharedClique clique = node->second;
+           clique && !removed.count(clique.get()); clique = clique->parent())
+        path.push_back(clique.get());
+      return path;
+    };
+    auto remove = [&](const std::vector<const ISAM2Clique*>& path) {
+      for (const ISAM2Clique* clique : path) {
+        removed.insert(clique);
+        nrReeliminated += clique->conditional()->nrFrontals();
+      }
+    };
+    for (Key key : markedKeys) remove(pathToRemoved(key));
+
+    std::vector<std::pair<double, Key>> candidates;
+    candidates.reserve(relinKeys->size());
+    for (Key key : *relinKeys)
+      candidates.emplace_back(delta[key].lpNorm<Eigen::Infinity>(), key);
+    std::sort(candidates.begin(), candidates.end(),
+              std::greater<std::pair<double, Key>>());
+
+    relinKeys->clear();
+    for (const auto& [magnitude, key] : candidates) {
+      const std::vector<const ISAM2Clique*> path = pathToRemoved(key);
+      size_t nrFrontals = 0;
+      for (const ISAM2Clique* clique : path)
+        nrFrontals += clique->conditional()->nrFrontals();
+      if (nrReeliminated + nrFrontals <= maxReeliminated) {
+        remove(path);
+        relinKeys->insert(key);
+      } else {
+        deferredKeys->insert(key);
+      }
+    }
+  }
+
   // Record relinerization threshold keys in detailed results
   void recordRelinearizeDetail(const KeySet& relinKeys,
                                ISAM2Result::DetailedResults* detail) const {
@@ -489,7 +545,7 @@ struct GTSAM_EXPORT UpdateImpl {
     gttic(GetAffectedFactors);
     FactorIndexSet indices;
     for (const Key key : keys) {
-      const FactorIndices& factors(variableIndex[key]);
+      const VariableIndex::Factors factors = variableIndex[key];
       indices.insert(factors.begin(), factors.end());
     }
     return indices;
@@ -25,7 +25,13 @@
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <utility>
 #include <variant>
@@ -76,28 +82,37 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
   gttoc(affectedKeysSet);
 
   gttic(check_candidates_and_linearize);
-  GaussianFactorGraph linearized;
-  for (const FactorIndex idx : candidates) {
-    bool inside = true;
+  // Each candidate is checked and linearized independently, writing only its
+  // own slot of results and of the linear factor cache, so this can run in
+  // parallel.  Non-sendable factors are linearized serially afterwards.
+  const FactorIndices candidateIndices(candidates.begin(), candidates.end());
+  FastVector<GaussianFactor::shared_ptr> results(candidateIndices.size());
+  FastVector<char> inside(candidateIndices.size(), 0);
+  FastVector<char> needsSerialLinearize(candidateIndices.size(), 0);
+  auto checkAndLinearize = [&](size_t i, bool serial) {
+    const FactorIndex idx = candidateIndices[i];
+    inside[i] = 1;
     bool useCachedLinear = params_.cacheLinearizedFactors;
     for (Key key : nonlinearFactors_[idx]->keys()) {
       if (affectedKeysSet.find(key) == affectedKeysSet.end()) {
-        inside = false;
+        inside[i] = 0;
         break;
       }
       if (useCachedLinear && relinKeys.find(key) != relinKeys.end())
         useCachedLinear = false;
     }
-    if (inside) {
+    if (inside[i]) {
       if (useCachedLinear) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
         assert(linearFactors_[idx]);
         assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
 #endif
-        linearized.push_back(linearFactors_[idx]);
+        results[i] = linearFactors_[idx];
+      } else if (!serial && !nonlinearFactors_[idx]->sendable()) {
+        needsSerialLinearize[i] = 1;
       } else {
         auto linearFactor = nonlinearFactors_[idx]->linearize(theta_);
-        linearized.push_back(linearFactor);
+        results[i] = linearFactor;
         if (params_.cacheLinearizedFactors) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
           assert(linearFactors_[idx]->keys() == linearFactor->keys());
@@ -106,7 +121,28 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
         }
       }
     }
+  };
+
+#ifdef GTSAM_USE_TBB
+  {
+    TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, candidateIndices.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          checkAndLinearize(i, false);
+                      });
   }
+  for (size_t i = 0; i < candidateIndices.size(); ++i)
+    if (needsSerialLinearize[i]) checkAndLinearize(i, true);
+#else
+  for (size_t i = 0; i < candidateIndices.size(); ++i)
+    checkAndLinearize(i, true);
+#endif
+
+  // Collect in candidate order, as the serial version did
+  GaussianFactorGraph linearized;
+  for (size_t i = 0; i < candidateIndices.size(); ++i)
+    if (inside[i]) linearized.push_back(results[i]);
   gttoc(check_candidates_and_linearize);
 
   return linearized;
@@ -196,21 +232,26 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   gttoc(add_keys);
 
   gttic(ordering);
-  Ordering order;
+  FastMap<Key, int> constraintGroups;
+  bool constrained = true;
   if (updateParams.constrainedKeys) {
-    order = Ordering::ColamdConstrained(affectedFactorsVarIndex,
-                                        *updateParams.constrainedKeys);
+    constraintGroups = *updateParams.constrainedKeys;
+  } else if (theta_.size() > result->observedKeys.size()) {
+    // Only if some variables are unconstrained
+    for (Key var : result->observedKeys) constraintGroups[var] = 1;
   } else {
-    if (theta_.size() > result->observedKeys.size()) {
-      // Only if some variables are unconstrained
-      FastMap<Key, int> constraintGroups;
-      for (Key var : result->observedKeys) constraintGroups[var] = 1;
-      order = Ordering::ColamdConstrained(affectedFactorsVarIndex,
-                                          constraintGroups);
-    } else {
-      order = Ordering::Colamd(affectedFactorsVarIndex);
-    }
+    constrained = false;
   }
+  auto computeOrdering = [&]() {
+    return constrained ? Ordering::ColamdConstrained(affectedFactorsVarIndex,
+                                                     constraintGroups)
+                       : Ordering::Colamd(affectedFactorsVarIndex);
+  };
+  const Ordering order =
+      params_.cacheOrderings
+          ? orderingCache_.ordering(OrderingCache::Topology(nonlinearFactors_),
+                                    constraintGroups, computeOrdering)
+          : computeOrdering();
   gttoc(ordering);
 
   gttic(linearize);
@@ -221,7 +262,8 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   gttic(eliminate);
   ISAM2BayesTree::shared_ptr bayesTree =
       ISAM2JunctionTree(
-          GaussianEliminationTree(*linearized, affectedFactorsVarIndex, order))
+          GaussianEliminationTree(*linearized, affectedFactorsVarIndex, order),
+          params_.amalgamation)
           .eliminate(params_.getEliminationFunction())
           .first;
   gttoc(eliminate);
@@ -346,7 +388,7 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
 
   // Do elimination
   GaussianEliminationTree etree(factors, affectedFactorsVarIndex, ordering);
-  auto bayesTree = ISAM2JunctionTree(etree)
+  auto bayesTree = ISAM2JunctionTree(etree, params_.amalgamation)
                        .eliminate(params_.getEliminationFunction())
                        .first;
   gttoc(reorder_and_eliminate);
@@ -380,6 +422,130 @@ void ISAM2::addVariables(const Values& newTheta,
   }
 }
 
+/* ************************************************************************* */
+double ISAM2::updateNonlinearError() {
+  gttic(updateNonlinearError);
+  const VectorValues& delta = getDelta();
+
+  // Variables whose estimate changed since the last evaluation, as recorded
+  // by updateDelta and the relinearization
+  KeySet changedKeys;
+  changedKeys.swap(errorDeltaKeys_);
+  changedKeys.insert(errorRelinKeys_.begin(), errorRelinKeys_.end());
+
+  // Factors to evaluate: new, removed, and those of the changed variables
+  FactorIndexSet factors;
+  for (size_t i = factorErrors_.size(); i < nonlinearFactors_.size(); ++i)
+    factors.insert(i);
+  factorErrors_.resize(nonlinearFactors_.size(), 0.0);
+  for (FactorIndex i : errorRemovedFactors_)
+    if (i < factorErrors_.size()) factors.insert(i);
+  for (Key key : changedKeys) {
+    const auto row = variableIndex_.find(key);
+    if (row == variableIndex_.end()) continue;
+    const VariableIndex::Factors keyFactors = (*row).second;
+    for (FactorIndex i : keyFactors) factors.insert(i);
+  }
+
+  // Estimate of the variables of these factors only
+  Values theta;
+  for (FactorIndex i : factors) {
+    if (!nonlinearFactors_[i]) continue;
+    for (Key key : *nonlinearFactors_[i])
+      if (!theta.exists(key)) theta.insert(key, theta_.at(key));
+  }
+  const Values estimate = theta.retract(delta);
+
+  for (FactorIndex i : factors) {
+    const double error =
+        nonlinearFactors_[i] ? nonlinearFactors_[i]->error(estimate) : 0.0;
+    nonlinearError_ += error - factorErrors_[i];
+    factorErrors_[i] = error;
+  }
+
+  errorRelinKeys_.clear();
+  errorRemovedFactors_.clear();
+  return nonlinearError_;
+}
+
+/* ************************************************************************* */
+size_t ISAM2::nrEmptyFactorSlots() const {
+  return nonlinearFactors_.size() - nonlinearFactors_.nrFactors();
+}
+
+/* ************************************************************************* */
+MemoryUsage ISAM2::memoryUsage() const {
+  MemoryUsage usage;
+  usage.add("nodes", nodes_.size() * sizeof(Nodes::value_type));
+  for (const auto& [key, clique] : nodes_) {
+    // Count each clique once, at its first frontal variable
+    if (!clique || clique->conditional()->front() != key) continue;
+    usage.add("conditionals", clique->conditional()->memoryUsage());
+    if (clique->cachedFactor())
+      usage.add("cachedFactors", clique->cachedFactor()->memoryUsage());
+    usage.add("cliques", sizeof(ISAM2Clique) +
+                             clique->children.capacity() * sizeof(sharedClique) +
+                             clique->gradientContribution().size() * sizeof(double));
+  }
+  usage.add("linearFactors", linearFactors_.memoryUsage());
+  usage.add("nonlinearFactorSlots",
+            nonlinearFactors_.size() * sizeof(NonlinearFactorGraph::sharedFactor));
+  usage.add("variableIndex", variableIndex_.memoryUsage());
+  usage.add("delta",
+            delta_.memoryUsage() + deltaNewton_.memoryUsage() + RgProd_.memoryUsage());
+  usage.add("errorCache", factorErrors_.capacity() * sizeof(double));
+  usage.add("theta", theta_.memoryUsage());
+  return usage;
+}
+
+/* ************************************************************************* */
+FactorIndices ISAM2::compactFactorSlots() {
+  gttic(compactFactorSlots);
+  const size_t n = nonlinearFactors_.size();
+  // Without caching, linearFactors_ can be shorter than the slots, as
+  // marginalizeLeaves only appends to nonlinearFactors_
+  assert(linearFactors_.size() == n ||
+         (!params_.cacheLinearizedFactors && linearFactors_.size() < n));
+
+  // Drop the errors of factors removed since they were last evaluated, the
+  // cache is kept only if it covers every slot
+  const bool keepErrors = factorErrors_.size() == n;
+  if (keepErrors) {
+    for (FactorIndex i : errorRemovedFactors_) {
+      nonlinearError_ -= factorErrors_[i];
+      factorErrors_[i] = 0.0;
+    }
+  } else {
+    factorErrors_.clear();
+    nonlinearError_ = 0.0;
+  }
+  errorRemovedFactors_.clear();
+
+  FactorIndices remap(n, kRemovedFactorSlot);
+  NonlinearFactorGraph nonlinearFactors;
+  GaussianFactorGraph linearFactors;
+  nonlinearFactors.reserve(nonlinearFactors_.nrFactors());
+  linearFactors.reserve(nonlinearFactors_.nrFactors());
+  size_t slot = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (!nonlinearFactors_[i]) continue;
+    remap[i] = slot;
+    nonlinearFactors.push_back(nonlinearFactors_[i]);
+    linearFactors.push_back(i < linearFactors_.size()
+                                ? linearFactors_[i]
+                                : GaussianFactor::shared_ptr());
+    if (keepErrors) factorErrors_[slot] = factorErrors_[i];
+    ++slot;
+  }
+  if (keepErrors) factorErrors_.resize(slot);
+  nonlinearFactors_ = std::move(nonlinearFactors);
+  linearFactors_ = std::move(linearFactors);
+
+  // Rebuild the variable index compactly
+  variableIndex_ = VariableIndex(nonlinearFactors_);
+  return remap;
+}
+
 /* ************************************************************************* */
 void ISAM2::removeVariables(const KeySet& unusedKeys) {
   gttic(removeVariables);
@@ -419,13 +585,18 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
                           const Values& newTheta,
                           const ISAM2UpdateParams& updateParams) {
   gttic(ISAM2_update);
+  const auto start = std::chrono::steady_clock::now();
   this->update_count_ += 1;
   UpdateImpl::LogStartingUpdate(newFactors, *this);
   ISAM2Result result(params_.enableDetailedResults);
   UpdateImpl update(params_, updateParams);
 
+  // Variables deferred by a deadline are checked again in the next update
+  const bool relinearize =
+      update.relinarizationNeeded(update_count_) || relinearizationDeferred_;
+
   // Update delta if we need it to check relinearization later
-  if (update.relinarizationNeeded(update_count_))
+  if (relinearize)
     updateDelta(updateParams.forceFullSolve);
 
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
@@ -438,8 +609,11 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   // 2. Initialize any new variables \Theta_{new} and add
   // \Theta:=\Theta\cup\Theta_{new}.
   addVariables(newTheta, result.details());
-  if (params_.evaluateNonlinearError)
-    update.error(nonlinearFactors_, calculateEstimate(), &result.errorBefore);
+  if (params_.evaluateNonlinearError) {
+    errorRemovedFactors_.insert(updateParams.removeFactorIndices.begin(),
+                                updateParams.removeFactorIndices.end());
+    result.errorBefore = updateNonlinearError();
+  }
 
   // 3. Mark linear update
   update.gatherInvolvedKeys(newFactors, nonlinearFactors_,
@@ -448,10 +622,21 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
 
   KeySet relinKeys;
   result.variablesRelinearized = 0;
-  if (update.relinarizationNeeded(update_count_)) {
-    // 4. Mark keys in \Delta above threshold \beta:
-    relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
-                                             &result.markedKeys);
+  if (relinearize) {
+    // 4. Mark keys in \Delta above threshold \beta, and defer those that do
+    // not fit before the deadline:
+    relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_);
+    if (updateParams.deadline && secondsPerReeliminated_ > 0.0) {
+      const double secondsLeft = std::chrono::duration<double>(
+          *updateParams.deadline - std::chrono::steady_clock::now()).count();
+      const size_t maxReeliminated =
+          secondsLeft > 0.0 ? size_t(secondsLeft / secondsPerReeliminated_) : 0;
+      UpdateImpl::DeferRelinearization(nodes_, delta_, maxReeliminated,
+                                       result.markedKeys, &relinKeys,
+                                       &result.deferredKeys);
+    }
+    relinearizationDeferred_ = !result.deferredKeys.empty();
+    result.markedKeys.insert(relinKeys.begin(), relinKeys.end());
     update.recordRelinearizeDetail(relinKeys, result.details());
     if (!relinKeys.empty()) {
       // 5. Mark cliques that involve marked variables \Theta_{J} and ancestors.
@@ -459,6 +644,8 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       // 6. Update linearization point for marked variables:
       // \Theta_{J}:=\Theta_{J}+\Delta_{J}.
       theta_.retractMasked(delta_, relinKeys);
+      if (params_.evaluateNonlinearError)
+        errorRelinKeys_.insert(relinKeys.begin(), relinKeys.end());
     }
     result.variablesRelinearized = result.markedKeys.size();
   }
@@ -475,7 +662,27 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   result.cliques = this->nodes().size();
 
   if (params_.evaluateNonlinearError)
-    update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
+    result.errorAfter = updateNonlinearError();
+
+  // Compact the factor slots if too many are empty
+  if (params_.factorSlotCompactionThreshold > 0.0 &&
+      nrEmptyFactorSlots() >
+          params_.factorSlotCompactionThreshold * nonlinearFactors_.size()) {
+    const FactorIndices remap = compactFactorSlots();
+    for (FactorIndex& index : result.newFactorsIndices) index = remap[index];
+    result.factorSlotRemap = remap;
+  }
+
+  // Update the running estimate of the time per re-eliminated variable
+  if (result.variablesReeliminated > 0) {
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count() /
+        result.variablesReeliminated;
+    secondsPerReeliminated_ = secondsPerReeliminated_ > 0.0
+                                  ? 0.5 * (secondsPerReeliminated_ + seconds)
+                                  : seconds;
+  }
   return result;
 }
 
@@ -688,6 +895,7 @@ void ISAM2::marginalizeLeaves(
     removedFactors.push_back(nonlinearFactors_[index]);
     nonlinearFactors_.remove(index);
     if (params_.cacheLinearizedFactors) linearFactors_.remove(index);
+    if (params_.evaluateNonlinearError) errorRemovedFactors_.insert(index);
   }
   variableIndex_.remove(factorIndicesToRemove.begin(),
                         factorIndicesToRemove.end(), removedFactors);
@@ -711,8 +919,9 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     const double effectiveWildfireThreshold =
         forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
-    DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
-                                      effectiveWildfireThreshold, &delta_);
+    DeltaImpl::UpdateGaussNewtonDelta(
+        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &delta_,
+        params_.evaluateNonlinearError ? &errorDeltaKeys_ : nullptr);
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
   } else if (std::holds_alternative<ISAM2DoglegParams>(params_.optimizationParams)) {
@@ -756,6 +965,8 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     delta_ =
         doglegResult
             .dx_d;  // Copy the VectorValues containing with the linear solution
+    if (params_.evaluateNonlinearError)
+      for (const auto& key_value : delta_) errorDeltaKeys_.insert(key_value.first);
     gttoc(Copy_dx_d);
   } else {
     throw std::runtime_error("iSAM2: unknown ISAM2Params type");
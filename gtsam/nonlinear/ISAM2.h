@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <gtsam/inference/OrderingCache.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
@@ -27,6 +28,7 @@
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <limits>
 #include <vector>
 
 namespace gtsam {
@@ -96,6 +98,27 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Orderings of recent batch re-eliminations, see ISAM2Params::cacheOrderings */
+  OrderingCache orderingCache_;
+
+  /** Running estimate of the update time per re-eliminated variable, used to
+   * meet ISAM2UpdateParams::deadline */
+  double secondsPerReeliminated_ = 0.0;
+
+  /** Whether the last update deferred relinearizing some variables */
+  bool relinearizationDeferred_ = false;
+
+  /** Errors of the nonlinear factors when last evaluated for
+   * Params::evaluateNonlinearError, and their sum */
+  std::vector<double> factorErrors_;
+  double nonlinearError_ = 0.0;
+
+  /** The variables whose delta changed, the variables relinearized, and the
+   * factors removed since the last evaluation of factorErrors_ */
+  mutable KeySet errorDeltaKeys_;
+  KeySet errorRelinKeys_;
+  FactorIndexSet errorRemovedFactors_;
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -103,6 +126,10 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   using sharedClique = Base::sharedClique;  ///< Shared pointer to a clique
   using Cliques = Base::Cliques;            ///< List of Cliques
 
+  /// Marks empty slots in the remapping returned by compactFactorSlots()
+  static constexpr FactorIndex kRemovedFactorSlot =
+      std::numeric_limits<FactorIndex>::max();
+
   /** Create an empty ISAM2 instance */
   explicit ISAM2(const ISAM2Params& params);
 
@@ -213,6 +240,29 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
           marginalizeLeaves(leafKeys, (&optArgs)...);
       }
 
+  /**
+   * Remove the empty slots left by removed and marginalized factors, moving
+   * the remaining factors to the front in their current order, and rebuild
+   * the variable index compactly.  Factor indices held by the caller must be
+   * mapped with the returned remapping: entry \c i is the new index of the
+   * factor in slot \c i, or kRemovedFactorSlot if the slot was empty.  See
+   * also ISAM2Params::factorSlotCompactionThreshold.
+   */
+  FactorIndices compactFactorSlots();
+
+  /// Number of empty factor slots, that compactFactorSlots() would remove
+  size_t nrEmptyFactorSlots() const;
+
+  /**
+   * Bytes used by this ISAM2, broken down by component: the "conditionals",
+   * "cachedFactors", "cliques" and "nodes" of the Bayes tree, the cached
+   * "linearFactors", the "nonlinearFactorSlots", the "variableIndex", the
+   * "delta" vectors, the "errorCache", and the linearization point per value
+   * type, as "theta.<type>".  The factors themselves are not traversed, so
+   * this is cheap enough to call after every update.
+   */
+  MemoryUsage memoryUsage() const;
+
   /// Access the current linearization point
   const Values& getLinearizationPoint() const { return theta_; }
 
@@ -339,6 +389,13 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
 
   void updateDelta(bool forceFullSolve = false) const;
 
+  /**
+   * The nonlinear error at the current estimate, re-evaluating only the new
+   * and removed factors and those of the variables whose estimate changed
+   * since the last call.
+   */
+  double updateNonlinearError();
+
  private:
 #ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
   /** Serialization function */
@@ -15,6 +15,7 @@
  * @author  Michael Kaess, Richard Roberts, Frank Dellaert
  */
 
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
 #include <gtsam/inference/BayesTreeCliqueBase-inst.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/linearAlgorithms-inst.h>
@@ -23,6 +24,13 @@
 #include <stack>
 #include <utility>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/task_arena.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -259,7 +267,7 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
 
 size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& keys,
-                                    VectorValues* delta) {
+                                    VectorValues* delta, KeySet* changedKeys) {
   KeySet changed;
   size_t count = 0;
 
@@ -280,9 +288,109 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
     }
   }
 
+  if (changedKeys) changedKeys->insert(changed.begin(), changed.end());
   return count;
 }
 
+/* ************************************************************************* */
+bool ISAM2Clique::optimizeWildfireNodeParallel(const KeySet& replaced,
+                                               double threshold,
+                                               const KeySet& parentChanged,
+                                               KeySet* changed,
+                                               VectorValues* delta) const {
+  // The separator is contained in the parent clique, so the changed separator
+  // variables are all in parentChanged
+  for (Key parent : conditional_->parents()) {
+    if (parentChanged.exists(parent)) changed->insert(parent);
+  }
+  const bool dirty =
+      replaced.exists(conditional_->frontals().front()) || !changed->empty();
+  if (dirty) {
+    // Temporary copy of the original values, to check how much they change
+    auto originalValues = delta->vector(conditional_->frontals());
+
+    // Back-substitute, writing the existing entries as delta is shared
+    const VectorValues solution = conditional_->solve(*delta);
+    for (const auto& [key, value] : solution) delta->at(key) = value;
+
+    if (valuesChanged(replaced, originalValues, *delta, threshold)) {
+      markFrontalsAsChanged(changed);
+    } else {
+      restoreFromOriginals(originalValues, delta);
+    }
+  }
+  return dirty;
+}
+
+#ifdef GTSAM_USE_TBB
+namespace {
+// A tree of cliques, as a forest for the tree traversals
+struct WildfireTree {
+  typedef ISAM2Clique Node;
+  FastVector<ISAM2Clique::shared_ptr> roots_;
+  const FastVector<ISAM2Clique::shared_ptr>& roots() const { return roots_; }
+};
+
+// Whether a clique was back-substituted, and which of its variables changed;
+// below a clique that was not, nothing is
+struct WildfireData {
+  bool dirty;
+  KeySet changed;
+};
+
+// Subtrees with less estimated back-substitution work than this, in variable
+// blocks, are not worth a task of their own
+const double kMinWildfireTaskWork = 1000.0;
+}  // namespace
+#endif
+
+size_t optimizeWildfireParallel(const ISAM2Clique::shared_ptr& root,
+                                double threshold, const KeySet& keys,
+                                VectorValues* delta, KeySet* changed) {
+#ifdef GTSAM_USE_TBB
+  if (!root) return 0;
+  const WildfireTree tree{{root}};
+  std::atomic<size_t> count(0);
+  std::mutex changedMutex;
+  auto visitorPre = [&](const ISAM2Clique::shared_ptr& clique,
+                        const WildfireData& parentData) {
+    WildfireData data{false, KeySet()};
+    if (parentData.dirty) {
+      const auto frontals = clique->conditional()->frontals();
+      data.dirty = clique->optimizeWildfireNodeParallel(
+          keys, threshold, parentData.changed, &data.changed, delta);
+      if (data.dirty) count += frontals.size();
+      if (changed && data.dirty && data.changed.exists(frontals.front())) {
+        std::lock_guard<std::mutex> lock(changedMutex);
+        changed->insert(frontals.begin(), frontals.end());
+      }
+    }
+    return data;
+  };
+  auto visitorPost = [](const ISAM2Clique::shared_ptr&, const WildfireData&) {};
+
+  // Back-substituting f frontal and s separator variables costs about
+  // f^2/2 + f s block operations
+  const treeTraversal::SubtreeWork<ISAM2Clique> subtreeWork(
+      tree, [](const ISAM2Clique& clique) {
+        const double f = clique.conditional()->nrFrontals(),
+                     s = clique.conditional()->nrParents();
+        return f * (f / 2.0 + s);
+      });
+  const double minTaskWork =
+      std::max(kMinWildfireTaskWork,
+               subtreeWork.total() / (4.0 * tbb::this_task_arena::max_concurrency()));
+
+  WildfireData rootData{true, KeySet()};
+  TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
+  treeTraversal::DepthFirstForestParallel(tree, rootData, visitorPre, visitorPost,
+                                          subtreeWork, minTaskWork);
+  return count;
+#else
+  return optimizeWildfireNonRecursive(root, threshold, keys, delta, changed);
+#endif
+}
+
 /* ************************************************************************* */
 void ISAM2Clique::nnz_internal(size_t* result) const {
   size_t dimR = conditional_->rows();
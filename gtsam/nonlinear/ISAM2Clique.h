@@ -96,6 +96,16 @@ class GTSAM_EXPORT ISAM2Clique
                             KeySet* changed, VectorValues* delta,
                             size_t* count) const;
 
+  /**
+   * optimizeWildfireNode for traversals that visit several cliques at once:
+   * the changed variables of the parent clique are read from \c parentChanged,
+   * and the changed variables of this clique are added to \c changed.  Only
+   * the entries of \c delta for the frontal variables are written.
+   */
+  bool optimizeWildfireNodeParallel(const KeySet& replaced, double threshold,
+                                    const KeySet& parentChanged,
+                                    KeySet* changed, VectorValues* delta) const;
+
   /**
    * Starting from the root, add up entries of frontal and conditional matrices
    * of each conditional
@@ -173,8 +183,23 @@ class GTSAM_EXPORT ISAM2Clique
 size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
                         const KeySet& replaced, VectorValues* delta);
 
+/// optimizeWildfire without recursion, adding the variables whose delta
+/// changed to \c changed if it is given
 size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& replaced,
-                                    VectorValues* delta);
+                                    VectorValues* delta,
+                                    KeySet* changed = nullptr);
+
+/**
+ * optimizeWildfire, visiting the subtrees of the Bayes tree in parallel with
+ * treeTraversal::DepthFirstForestParallel: a subtree is back-substituted in a
+ * task of its own if its estimated work is large enough.  The result is the
+ * same as that of optimizeWildfireNonRecursive, which is used when GTSAM is
+ * built without TBB, including the variables added to \c changed.
+ */
+size_t optimizeWildfireParallel(const ISAM2Clique::shared_ptr& root,
+                                double threshold, const KeySet& replaced,
+                                VectorValues* delta,
+                                KeySet* changed = nullptr);
 
 }  // namespace gtsam
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <gtsam/inference/JunctionTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 
@@ -224,6 +225,22 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /// Compact the factor slots at the end of ISAM2::update() once more than
+  /// this fraction of them is empty, see ISAM2::compactFactorSlots()
+  /// (default: 0, never).  Compaction renumbers the factors, the new indices
+  /// are reported in ISAM2Result::factorSlotRemap.
+  double factorSlotCompactionThreshold = 0.0;
+
+  /// Cache the orderings of batch re-eliminations by factor graph topology
+  /// (default: false).  A repeated topology re-uses its ordering, a topology
+  /// that only grew by a few variables extends the previous ordering.
+  bool cacheOrderings = false;
+
+  /// Relaxed supernode amalgamation when re-eliminating the top of the tree
+  /// (default: disabled).  Merging tiny cliques, e.g. in pose chains, reduces
+  /// the per-clique overhead at the cost of storing some zero blocks.
+  AmalgamationParams amalgamation;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -290,6 +307,11 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "factorSlotCompactionThreshold:     "
+         << factorSlotCompactionThreshold << "\n";
+    cout << "cacheOrderings:                    " << cacheOrderings << "\n";
+    cout << "amalgamation.maxZeroFraction:      "
+         << amalgamation.maxZeroFraction << "\n";
     cout.flush();
   }
 
@@ -108,6 +108,15 @@ struct ISAM2Result {
   /** All keys that were marked during the update process. */
   KeySet markedKeys;
 
+  /** Keys above the relinearization threshold that were not relinearized to
+   * meet ISAM2UpdateParams::deadline, they are checked again next update. */
+  KeySet deferredKeys;
+
+  /** If the factor slots were compacted at the end of the update, the new
+   * index of every old factor slot, or ISAM2::kRemovedFactorSlot for empty
+   * slots.  newFactorsIndices are already the new indices. */
+  std::optional<FactorIndices> factorSlotRemap;
+
   /**
    * A struct holding detailed results, which must be enabled with
    * ISAM2Params::enableDetailedResults.
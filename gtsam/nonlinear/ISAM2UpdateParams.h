@@ -20,6 +20,7 @@
 #include <gtsam/dllexport.h>              // GTSAM_EXPORT
 #include <gtsam/inference/Key.h>          // Key, KeySet
 #include <gtsam/nonlinear/ISAM2Result.h>  //FactorIndices
+#include <chrono>
 #include <optional>
 
 namespace gtsam {
@@ -69,6 +70,17 @@ struct ISAM2UpdateParams {
    * the deltas become too small down in the tree. This flagg forces a full
    * solve instead. */
   bool forceFullSolve{false};
+
+  /** An optional deadline for this update.  The variables above the
+   * relinearization threshold are relinearized in order of decreasing delta,
+   * for as long as the re-elimination this causes is estimated to finish
+   * before the deadline; the estimate uses the time earlier updates took per
+   * re-eliminated variable.  The other variables keep their linearization
+   * point, are reported in ISAM2Result::deferredKeys, and are checked again
+   * in the next update regardless of Params::relinearizeSkip.  New factors
+   * and removals are always applied, so the deadline only bounds the
+   * relinearization work. */
+  std::optional<std::chrono::steady_clock::time_point> deadline;
 };
 
 }  // namespace gtsam
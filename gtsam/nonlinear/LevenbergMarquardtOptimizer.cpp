@@ -20,11 +20,15 @@
 
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/internal/LevenbergMarquardtState.h>
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/Scatter.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/inferenceExceptions.h>
 #include <gtsam/base/Vector.h>
 #ifdef GTSAM_USE_BOOST_FEATURES
 #include <gtsam/base/timing.h>
@@ -61,6 +65,17 @@ LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGr
                                                   params.lambdaInitial, params.lambdaFactor))),
       params_(LevenbergMarquardtParams::ReplaceOrdering(params, ordering)) {}
 
+LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(
+    const std::shared_ptr<CompiledFactorGraph>& compiled, const Values& initialValues,
+    const LevenbergMarquardtParams& params)
+    : NonlinearOptimizer(
+          compiled->graph(),
+          std::unique_ptr<State>(new State(initialValues, compiled->error(initialValues),
+                                           params.lambdaInitial, params.lambdaFactor))),
+      params_(LevenbergMarquardtParams::ReplaceOrdering(params, compiled->ordering())) {
+  compiled_ = compiled;
+}
+
 /* ************************************************************************* */
 void LevenbergMarquardtOptimizer::initTime() {
   // use chrono to measure time in microseconds
@@ -81,7 +96,7 @@ int LevenbergMarquardtOptimizer::getInnerIterations() const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearize() const {
-  return graph_.linearize(state_->values);
+  return linearizeGraph(state_->values);
 }
 
 /* ************************************************************************* */
@@ -99,6 +114,69 @@ GaussianFactorGraph LevenbergMarquardtOptimizer::buildDampedSystem(
     return currentState->buildDampedSystem(linear);
 }
 
+/* ************************************************************************* */
+VectorValues LevenbergMarquardtOptimizer::solveDamped(
+    const GaussianFactorGraph& linear, const VectorValues& sqrtHessianDiagonal) {
+  gttic(solveDamped);
+  auto currentState = static_cast<const State*>(state_.get());
+
+  if (params_.verbosityLM >= LevenbergMarquardtParams::DAMPED)
+    std::cout << "damping cliques with lambda " << currentState->lambda << std::endl;
+
+  // Ordering, elimination tree and junction tree only depend on the keys
+  if (!structure_ || !structure_->matches(linear)) {
+    gttic(structure);
+    try {
+      structure_ = std::make_shared<GaussianJunctionTree::Structure>(
+          linear, *params_.ordering, params_.amalgamation);
+    } catch (const std::invalid_argument&) {
+      // Some ordered variables only get a factor from the damping
+      structure_.reset();
+      reuseStructure_ = false;
+      return solve(buildDampedSystem(linear, sqrtHessianDiagonal), params_);
+    }
+  }
+
+  // Equivalent to eliminating the graph built by buildDampedSystem: each
+  // variable is frontal in exactly one clique, and its prior would add
+  // lambda*I, or lambda*diag(H), to its diagonal block of the clique Hessian.
+  const double lambda = currentState->lambda;
+  const bool diagonalDamping = params_.diagonalDamping;
+  auto eliminateDamped = [&](const GaussianFactorGraph& factors,
+                             const Ordering& keys) {
+    gttic(EliminateDampedCholesky);
+    HessianFactor::shared_ptr jointFactor;
+    try {
+      Scatter scatter(factors, keys);
+      jointFactor = std::make_shared<HessianFactor>(factors, scatter);
+    } catch (std::invalid_argument&) {
+      throw InvalidDenseElimination(
+          "EliminateCholesky was called with a request to eliminate variables that are not\n"
+          "involved in the provided factors.");
+    }
+    SymmetricBlockMatrix& info = jointFactor->info();
+    for (size_t j = 0; j < keys.size(); ++j) {
+      Vector damping;
+      if (diagonalDamping) {
+        auto it = sqrtHessianDiagonal.find(keys[j]);
+        if (it == sqrtHessianDiagonal.end()) continue;
+        damping = lambda * it->second.array().square();
+      } else {
+        damping = Vector::Constant(info.getDim(j), lambda);
+      }
+      info.updateDiagonalBlock(j, Matrix(damping.asDiagonal()));
+    }
+    auto conditional = jointFactor->eliminateCholesky(keys);
+    return std::make_pair(conditional, std::static_pointer_cast<GaussianFactor>(jointFactor));
+  };
+
+  const GaussianJunctionTree junctionTree(linear, *structure_);
+  const auto [bayesTree, remaining] = junctionTree.eliminate(eliminateDamped);
+  if (!remaining->empty())
+    throw InconsistentEliminationRequested();
+  return bayesTree->optimize();
+}
+
 /* ************************************************************************* */
 // Log current error/lambda to file
 inline void LevenbergMarquardtOptimizer::writeLogFile(double currentError){
@@ -138,8 +216,19 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
   if (verbose)
     cout << "trying lambda = " << currentState->lambda << endl;
 
-  // Build damped system for this lambda (adds prior factors that make it like gradient descent)
-  auto dampedSystem = buildDampedSystem(linear, sqrtHessianDiagonal);
+  // With multifrontal Cholesky, the damping is applied during elimination, and
+  // the symbolic structure is shared between lambda trials and iterations.
+  const bool dampDuringElimination =
+      !compiled_ && reuseStructure_ &&
+      params_.linearSolverType == NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY &&
+      params_.ordering && params_.ordering->size() == currentState->values.size() &&
+      !hasConstraints(linear);
+
+  // Otherwise build damped system for this lambda (adds prior factors that make it like gradient descent)
+  // A compiled graph adds the damping to the diagonal of its normal equations.
+  GaussianFactorGraph dampedSystem;
+  if (!dampDuringElimination && !compiled_)
+    dampedSystem = buildDampedSystem(linear, sqrtHessianDiagonal);
 
   // Try solving
   double modelFidelity = 0.0;
@@ -152,7 +241,13 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
   bool systemSolvedSuccessfully;
   try {
     // ============ Solve is where most computation happens !! =================
-    delta = solve(dampedSystem, params_);
+    if (compiled_)
+      delta = compiled_->solve(
+          linear, compiled_->damping(currentState->lambda, sqrtHessianDiagonal));
+    else if (dampDuringElimination)
+      delta = solveDamped(linear, sqrtHessianDiagonal);
+    else
+      delta = solve(dampedSystem, params_);
     systemSolvedSuccessfully = true;
   } catch (const IndeterminantLinearSystemException&) {
     systemSolvedSuccessfully = false;
@@ -22,6 +22,7 @@
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtParams.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/VectorValues.h>
 #include <chrono>
 
@@ -40,6 +41,14 @@ protected:
   // startTime_ is a chrono time point
   std::chrono::time_point<std::chrono::high_resolution_clock> startTime_; ///< time when optimization started
 
+  /// Symbolic structure of the linearized system, re-used across lambda trials
+  /// and iterations for as long as the sparsity pattern does not change.
+  std::shared_ptr<GaussianJunctionTree::Structure> structure_;
+
+  /// Cleared if the damped system cannot be solved with a cached structure,
+  /// e.g. if the ordering contains variables that no factor involves.
+  bool reuseStructure_ = true;
+
   void initTime();
 
 public:
@@ -70,6 +79,17 @@ public:
                               const Ordering& ordering,
                               const LevenbergMarquardtParams& params = LevenbergMarquardtParams());
 
+  /** Optimize a compiled graph with its ordering.  The damped normal equations
+   * are solved with the precomputed structure of the compiled graph, regardless
+   * of params.linearSolverType.
+   * @param compiled The compiled graph to optimize
+   * @param initialValues The initial variable assignments
+   * @param params The optimization parameters
+   */
+  LevenbergMarquardtOptimizer(const std::shared_ptr<CompiledFactorGraph>& compiled,
+                              const Values& initialValues,
+                              const LevenbergMarquardtParams& params = LevenbergMarquardtParams());
+
   /** Virtual destructor */
   ~LevenbergMarquardtOptimizer() override {
   }
@@ -116,6 +136,15 @@ public:
   GaussianFactorGraph buildDampedSystem(const GaussianFactorGraph& linear,
                                         const VectorValues& sqrtHessianDiagonal) const;
 
+  /**
+   * Solve the system damped for the current lambda, without building a damped
+   * graph: the symbolic structure of the undamped system is cached, and the
+   * damping is added to the diagonal blocks of each clique's Hessian during
+   * multifrontal Cholesky elimination.
+   */
+  VectorValues solveDamped(const GaussianFactorGraph& linear,
+                           const VectorValues& sqrtHessianDiagonal);
+
   /** Inner loop, changes state, returns true if successful or giving up */
   bool tryLambda(const GaussianFactorGraph& linear, const VectorValues& sqrtHessianDiagonal);
 
@@ -134,6 +134,13 @@ Matrix Marginals::marginalCovariance(Key variable) const {
   return marginalInformation(variable).inverse();
 }
 
+/* ************************************************************************* */
+GaussianBayesTree::CovarianceBlocks Marginals::covarianceBlocks(
+    const std::vector<std::pair<Key, Key> >& offDiagonal) const {
+  gttic(covarianceBlocks);
+  return bayesTree_.covarianceBlocks(offDiagonal);
+}
+
 /* ************************************************************************* */
 JointMarginal Marginals::jointMarginalCovariance(const KeyVector& variables) const {
   JointMarginal info = jointMarginalInformation(variables);
@@ -119,6 +119,12 @@ public:
   /** Compute the joint marginal information of several variables */
   JointMarginal jointMarginalInformation(const KeyVector& variables) const;
 
+  /** Compute the marginal covariances of all variables, and the cross-covariances of the
+   * requested pairs of variables that share a clique, in a single pass over the Bayes tree.
+   * See GaussianBayesTree::covarianceBlocks. */
+  GaussianBayesTree::CovarianceBlocks covarianceBlocks(
+      const std::vector<std::pair<Key, Key> >& offDiagonal = {}) const;
+
   /** Optimize the bayes tree */
   VectorValues optimize() const;
 
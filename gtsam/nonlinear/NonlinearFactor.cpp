@@ -181,6 +181,40 @@ std::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
   }
 }
 
+/* ************************************************************************* */
+bool NoiseModelFactor::linearizeJacobianInPlace(const Values& x,
+                                                GaussianFactor& factor) const {
+  auto jacobian = dynamic_cast<JacobianFactor*>(&factor);
+  if (!jacobian || jacobian->get_model() || jacobian->keys() != keys() ||
+      (noiseModel_ && noiseModel_->isConstrained()) || !active(x))
+    return false;
+
+  // Scratch Jacobians keep their storage across consecutive factors of the
+  // same shape, which is the common case in large problems
+  thread_local std::vector<Matrix> A;
+  A.resize(size());
+  Vector b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // Check the structure before anything is overwritten
+  if (size_t(b.size()) != jacobian->rows())
+    return false;
+  for (size_t j = 0; j < size(); ++j) {
+    if (A[j].rows() != b.size() ||
+        A[j].cols() != jacobian->getDim(jacobian->begin() + j))
+      return false;
+  }
+
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  VerticalBlockMatrix& Ab = jacobian->matrixObject();
+  for (size_t j = 0; j < size(); ++j)
+    Ab(j) = A[j];
+  Ab(size()).col(0) = b;
+  return true;
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
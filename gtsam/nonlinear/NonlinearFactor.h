@@ -147,6 +147,20 @@ public:
   virtual std::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Linearize into an existing GaussianFactor, overwriting its values in
+   * place, to reuse the storage of a previous linearization (see
+   * LinearizationArena).  Returns false and leaves \c factor unchanged if it
+   * does not have the type and structure linearize() would produce, or if
+   * this factor does not support it; the default never does.  Factors opt in
+   * explicitly, and must give up if their dynamic type may override
+   * linearize(), since the result has to be the same.
+   */
+  virtual bool linearizeInPlace(const Values& /*c*/,
+                                GaussianFactor& /*factor*/) const {
+    return false;
+  }
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -231,6 +245,15 @@ protected:
    */
   NoiseModelFactor(const SharedNoiseModel& noiseModel) : noiseModel_(noiseModel) {}
 
+  /**
+   * Implementation of linearizeInPlace for factors whose linearize() is the
+   * one of this class: linearize into a JacobianFactor without a noise model
+   * and with the same keys and dimensions, as produced by linearize() for
+   * unconstrained noise models.  The Jacobians are evaluated into per-thread
+   * scratch matrices.
+   */
+  bool linearizeJacobianInPlace(const Values& x, GaussianFactor& factor) const;
+
 public:
   /** Print */
   void print(const std::string& s = "",
@@ -34,6 +34,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <fstream>
 #include <set>
@@ -169,6 +170,14 @@ void NonlinearFactorGraph::saveGraph(const std::string& filename,
 /* ************************************************************************* */
 double NonlinearFactorGraph::error(const Values& values) const {
   gttic(NonlinearFactorGraph_error);
+#ifdef GTSAM_USE_TBB
+  // Sum in factor order, same as the serial loop below
+  const Vector errors = factorErrors(values);
+  double total_error = 0.;
+  for (Eigen::Index i = 0; i < errors.size(); i++)
+    total_error += errors[i];
+  return total_error;
+#else
   double total_error = 0.;
   // iterate over all the factors_ to accumulate the log probabilities
   for(const sharedFactor& factor: factors_) {
@@ -176,6 +185,60 @@ double NonlinearFactorGraph::error(const Values& values) const {
       total_error += factor->error(values);
   }
   return total_error;
+#endif
+}
+
+/* ************************************************************************* */
+namespace {
+/* Evaluate the errors of factors index(0) ... index(n - 1) into errors */
+template <class INDEX>
+void evaluateFactorErrors(const FactorGraph<NonlinearFactor>& graph, const Values& values,
+                          size_t n, const INDEX& index, Vector* errors) {
+#ifdef GTSAM_USE_TBB
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+
+  // First evaluate all sendable factors
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t k = range.begin(); k != range.end(); ++k) {
+        const size_t i = index(k);
+        if (graph[i] && graph[i]->sendable())
+          (*errors)[i] = graph[i]->error(values);
+      }
+    });
+
+  // Evaluate all non-sendable factors
+  for (size_t k = 0; k < n; k++) {
+    const size_t i = index(k);
+    if (graph[i] && !graph[i]->sendable())
+      (*errors)[i] = graph[i]->error(values);
+  }
+#else
+  for (size_t k = 0; k < n; k++) {
+    const size_t i = index(k);
+    if (graph[i])
+      (*errors)[i] = graph[i]->error(values);
+  }
+#endif
+}
+}  // namespace
+
+/* ************************************************************************* */
+Vector NonlinearFactorGraph::factorErrors(const Values& values) const {
+  gttic(NonlinearFactorGraph_factorErrors);
+  Vector errors = Vector::Zero(size());
+  evaluateFactorErrors(*this, values, size(), [](size_t k) { return k; }, &errors);
+  return errors;
+}
+
+/* ************************************************************************* */
+Vector NonlinearFactorGraph::factorErrors(const Values& values,
+                                          const FactorIndices& indices) const {
+  gttic(NonlinearFactorGraph_factorErrors);
+  Vector errors = Vector::Zero(size());
+  evaluateFactorErrors(*this, values, indices.size(),
+                       [&indices](size_t k) { return indices[k]; }, &errors);
+  return errors;
 }
 
 /* ************************************************************************* */
@@ -277,6 +340,63 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(
+    const Values& linearizationPoint, LinearizationArena& arena) const {
+  gttic(NonlinearFactorGraph_linearize);
+
+  // The previous graph can only be reused if nobody else holds it
+  GaussianFactorGraph::shared_ptr& linearFG = arena.graph_;
+  if (!linearFG || linearFG.use_count() > 1)
+    linearFG = std::make_shared<GaussianFactorGraph>();
+  linearFG->resize(size());
+
+  // Linearize factor i, in place if its previous linearization is not shared
+  auto linearizeFactor = [&](size_t i) -> bool {
+    const sharedFactor& factor = factors_[i];
+    GaussianFactor::shared_ptr& linear = (*linearFG)[i];
+    if (!factor) {
+      linear.reset();
+      return false;
+    }
+    if (linear && linear.use_count() == 1 &&
+        factor->linearizeInPlace(linearizationPoint, *linear))
+      return true;
+    linear = factor->linearize(linearizationPoint);
+    return false;
+  };
+
+  size_t nrReused = 0;
+#ifdef GTSAM_USE_TBB
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+
+  // First linearize all sendable factors
+  std::atomic<size_t> nrReusedSendable(0);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+    [&](const tbb::blocked_range<size_t>& range) {
+      size_t count = 0;
+      for (size_t i = range.begin(); i != range.end(); ++i)
+        if (!factors_[i] || factors_[i]->sendable())
+          count += linearizeFactor(i);
+      nrReusedSendable += count;
+    });
+  nrReused = nrReusedSendable;
+
+  // Linearize all non-sendable factors
+  for (size_t i = 0; i < size(); i++) {
+    if (factors_[i] && !factors_[i]->sendable())
+      nrReused += linearizeFactor(i);
+  }
+#else
+  for (size_t i = 0; i < size(); i++)
+    nrReused += linearizeFactor(i);
+#endif
+
+  arena.nrReused_ = nrReused;
+  arena.nrAllocated_ = linearFG->nrFactors() - nrReused;
+  return linearFG;
+}
+
 /* ************************************************************************* */
 static Scatter scatterFromValues(const Values& values) {
   gttic(scatterFromValues);
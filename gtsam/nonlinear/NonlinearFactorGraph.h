@@ -42,6 +42,31 @@ namespace gtsam {
   template<typename T>
   class ExpressionFactor;
 
+  /**
+   * Storage of a linearized factor graph that is reused across
+   * linearizations, see NonlinearFactorGraph::linearize(const Values&,
+   * LinearizationArena&).  When the previous linear graph and its factors are
+   * no longer referenced outside the arena, factors whose structure did not
+   * change are overwritten in place instead of being reallocated.
+   */
+  class GTSAM_EXPORT LinearizationArena {
+  public:
+    /// Number of factors overwritten in place by the last linearization
+    size_t nrReused() const { return nrReused_; }
+
+    /// Number of factors allocated by the last linearization
+    size_t nrAllocated() const { return nrAllocated_; }
+
+    /// Release the stored linear graph
+    void clear() { graph_.reset(); nrReused_ = nrAllocated_ = 0; }
+
+  private:
+    friend class NonlinearFactorGraph;
+    std::shared_ptr<GaussianFactorGraph> graph_;
+    size_t nrReused_ = 0;
+    size_t nrAllocated_ = 0;
+  };
+
   /**
    * A NonlinearFactorGraph is a graph of non-Gaussian, i.e. non-linear factors,
    * which derive from NonlinearFactor. The values structures are typically (in
@@ -103,9 +128,19 @@ namespace gtsam {
     /// @name Standard Interface
     /// @{
 
-    /** unnormalized error, \f$ \sum_i 0.5 (h_i(X_i)-z)^2 / \sigma^2 \f$ in the most common case */
+    /** unnormalized error, \f$ \sum_i 0.5 (h_i(X_i)-z)^2 / \sigma^2 \f$ in the most common case.
+     * With TBB the factors are evaluated in parallel, and the result is summed in
+     * factor order, so it does not depend on the number of threads. */
     double error(const Values& values) const;
 
+    /** The error of every factor, zero for null factors.  Evaluated in parallel
+     * with TBB, like linearize. */
+    Vector factorErrors(const Values& values) const;
+
+    /** The error of the factors with the given \c indices, zero for all other
+     * factors.  Evaluated in parallel with TBB, like linearize. */
+    Vector factorErrors(const Values& values, const FactorIndices& indices) const;
+
     /** Unnormalized probability. O(n) */
     double probPrime(const Values& values) const;
 
@@ -132,6 +167,16 @@ namespace gtsam {
     /// Linearize a nonlinear factor graph
     std::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * Linearize a nonlinear factor graph into the storage of \c arena.  The
+     * returned graph is the one held by the arena; as long as the caller
+     * releases it before the next call, factors with unchanged structure are
+     * overwritten in place through NonlinearFactor::linearizeInPlace.  Graphs
+     * or factors still referenced elsewhere are never modified.
+     */
+    std::shared_ptr<GaussianFactorGraph> linearize(
+        const Values& linearizationPoint, LinearizationArena& arena) const;
+
     /// typdef for dampen functions used below
     typedef std::function<void(const std::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
 
@@ -17,11 +17,15 @@
  */
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
 #include <gtsam/nonlinear/internal/NonlinearOptimizerState.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/SparseCholeskySolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -42,6 +46,16 @@ NonlinearOptimizer::NonlinearOptimizer(const NonlinearFactorGraph& graph,
                                        std::unique_ptr<internal::NonlinearOptimizerState> state)
     : graph_(graph), state_(std::move(state)) {}
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearOptimizer::linearizeGraph(
+    const Values& values) const {
+  if (compiled_)
+    return compiled_->linearize(values);
+  if (_params().reuseLinearization)
+    return graph_.linearize(values, linearizationArena_);
+  return graph_.linearize(values);
+}
+
 /* ************************************************************************* */
 NonlinearOptimizer::~NonlinearOptimizer() {}
 
@@ -137,10 +151,31 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
   // Check which solver we are using
   if (params.isMultifrontal()) {
     // Multifrontal QR or Cholesky (decided by params.getEliminationFunction())
-    if (params.ordering)
-      delta = gfg.optimize(*params.ordering, params.getEliminationFunction());
+    GaussianBayesTree::shared_ptr bayesTree;
+    if (params.amalgamation.relaxed()) {
+      // Build the junction tree here, to amalgamate its cliques
+      const VariableIndex variableIndex(gfg);
+      const Ordering ordering =
+          params.ordering ? *params.ordering : Ordering::Colamd(variableIndex);
+      bayesTree = GaussianJunctionTree(
+                      GaussianEliminationTree(gfg, variableIndex, ordering),
+                      params.amalgamation)
+                      .eliminate(params.getEliminationFunction())
+                      .first;
+    } else if (params.ordering)
+      bayesTree = gfg.eliminateMultifrontal(*params.ordering,
+                                            params.getEliminationFunction());
     else
-      delta = gfg.optimize(params.getEliminationFunction());
+      bayesTree = gfg.eliminateMultifrontal(Ordering::COLAMD,
+                                            params.getEliminationFunction());
+    delta = bayesTree->optimize();
+
+    // A single-precision factorization is refined with the residuals of the
+    // linear system, unless constraints made it fall back to QR
+    if (params.linearSolverType ==
+            NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY_MIXED &&
+        !hasConstraints(gfg))
+      delta = bayesTree->refine(gfg, delta);
   } else if (params.isSequential()) {
     // Sequential QR or Cholesky (decided by params.getEliminationFunction())
     if (params.ordering)
@@ -159,7 +194,15 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
 
     if (auto pcg = std::dynamic_pointer_cast<PCGSolverParameters>(
             params.iterativeParams)) {
-      delta = PCGSolver(*pcg).optimize(gfg);
+      // Keep the solver, and with it the preconditioner's cached data, for
+      // as long as the same parameters are used
+      if (!pcgSolver_ || pcgParameters_ != pcg ||
+          pcgPreconditionerParameters_ != pcg->preconditioner_) {
+        pcgSolver_ = std::make_shared<PCGSolver>(*pcg);
+        pcgParameters_ = pcg;
+        pcgPreconditionerParameters_ = pcg->preconditioner_;
+      }
+      delta = pcgSolver_->optimize(gfg);
     } else if (auto spcg =
                    std::dynamic_pointer_cast<SubgraphSolverParameters>(
                        params.iterativeParams)) {
@@ -170,6 +213,15 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
       throw std::runtime_error(
           "NonlinearOptimizer::solve: special cg parameter type is not handled in LM solver ...");
     }
+  } else if (params.isCholmod()) {
+    // Sparse Cholesky on the normal equations, keeping the symbolic analysis
+    // for as long as the linearized graph keeps the same structure
+    if (!sparseCholesky_)
+      sparseCholesky_ = std::make_shared<SparseCholeskySolver>();
+    if (params.ordering)
+      delta = sparseCholesky_->solve(gfg, *params.ordering);
+    else
+      delta = sparseCholesky_->solve(gfg, params.orderingType);
   } else {
     throw std::runtime_error("NonlinearOptimizer::solve: Optimization parameter is invalid");
   }
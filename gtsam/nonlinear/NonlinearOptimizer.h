@@ -24,6 +24,11 @@
 namespace gtsam {
 
 namespace internal { struct NonlinearOptimizerState; }
+class SparseCholeskySolver;
+class CompiledFactorGraph;
+class PCGSolver;
+struct PCGSolverParameters;
+struct PreconditionerParameters;
 
 /**
  * This is the abstract interface for classes that can optimize for the
@@ -79,6 +84,24 @@ protected:
 
   std::unique_ptr<internal::NonlinearOptimizerState> state_; ///< PIMPL'd state
 
+  /// Sparse solver for the CHOLMOD linear solver type, cached so the symbolic
+  /// analysis is reused across iterations
+  mutable std::shared_ptr<SparseCholeskySolver> sparseCholesky_;
+
+  /// PCG solver, cached so its preconditioner can reuse work across
+  /// iterations, and the parameters it was created with
+  mutable std::shared_ptr<PCGSolver> pcgSolver_;
+  mutable std::shared_ptr<const PCGSolverParameters> pcgParameters_;
+  mutable std::shared_ptr<const PreconditionerParameters> pcgPreconditionerParameters_;
+
+  /// Storage of the last linearization, overwritten in place by the next one
+  /// if NonlinearOptimizerParams::reuseLinearization is set
+  mutable LinearizationArena linearizationArena_;
+
+  /// Precomputed structure of graph_, if the optimizer was constructed from a
+  /// CompiledFactorGraph
+  std::shared_ptr<CompiledFactorGraph> compiled_;
+
 public:
   /** A shared pointer to this class */
   using shared_ptr = std::shared_ptr<const NonlinearOptimizer>;
@@ -145,6 +168,10 @@ protected:
 
   virtual const NonlinearOptimizerParams& _params() const = 0;
 
+  /// Linearize graph_, through the compiled graph if there is one, reusing
+  /// the storage of the previous linearization if the parameters ask for it
+  GaussianFactorGraph::shared_ptr linearizeGraph(const Values& values) const;
+
   /** Constructor for initial construction of base classes. Takes ownership of state. */
   NonlinearOptimizer(const NonlinearFactorGraph& graph,
                      std::unique_ptr<internal::NonlinearOptimizerState> state);
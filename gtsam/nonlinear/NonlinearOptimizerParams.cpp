@@ -82,6 +82,7 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   std::cout << "         maximum iterations: " << maxIterations << "\n";
   std::cout << "                  verbosity: " << verbosityTranslator(verbosity)
       << "\n";
+  std::cout << "        reuse linearization: " << reuseLinearization << "\n";
   std::cout.flush();
 
   switch (linearSolverType) {
@@ -100,6 +101,9 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case CHOLMOD:
     std::cout << "         linear solver type: CHOLMOD\n";
     break;
+  case MULTIFRONTAL_CHOLESKY_MIXED:
+    std::cout << "         linear solver type: MULTIFRONTAL CHOLESKY MIXED\n";
+    break;
   case Iterative:
     std::cout << "         linear solver type: ITERATIVE\n";
     break;
@@ -139,6 +143,8 @@ std::string NonlinearOptimizerParams::linearSolverTranslator(
     return "ITERATIVE";
   case CHOLMOD:
     return "CHOLMOD";
+  case MULTIFRONTAL_CHOLESKY_MIXED:
+    return "MULTIFRONTAL_CHOLESKY_MIXED";
   default:
     throw std::invalid_argument(
         "Unknown linear solver type in SuccessiveLinearizationOptimizer");
@@ -160,6 +166,8 @@ NonlinearOptimizerParams::LinearSolverType NonlinearOptimizerParams::linearSolve
     return Iterative;
   if (linearSolverType == "CHOLMOD")
     return CHOLMOD;
+  if (linearSolverType == "MULTIFRONTAL_CHOLESKY_MIXED")
+    return MULTIFRONTAL_CHOLESKY_MIXED;
   throw std::invalid_argument(
       "Unknown linear solver type in SuccessiveLinearizationOptimizer");
 }
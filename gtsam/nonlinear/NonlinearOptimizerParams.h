@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <gtsam/inference/JunctionTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphSolver.h>
 
@@ -102,11 +103,14 @@ public:
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
     CHOLMOD, /* Experimental Flag */
+    MULTIFRONTAL_CHOLESKY_MIXED, /* Single-precision factorization, refined in double precision */
   };
 
   LinearSolverType linearSolverType = MULTIFRONTAL_CHOLESKY; ///< The type of linear solver to use in the nonlinear optimizer
   std::optional<Ordering> ordering; ///< The optional variable elimination ordering, or empty to use COLAMD (default: empty)
   IterativeOptimizationParameters::shared_ptr iterativeParams; ///< The container for iterativeOptimization parameters. used in CG Solvers.
+  AmalgamationParams amalgamation; ///< Relaxed supernode amalgamation for multifrontal solvers (default: disabled)
+  bool reuseLinearization = false; ///< Overwrite the previous linearization in place for factors that support it, see LinearizationArena (default: false)
 
   NonlinearOptimizerParams() = default;
   virtual ~NonlinearOptimizerParams() {
@@ -127,7 +131,8 @@ public:
 
   inline bool isMultifrontal() const {
     return (linearSolverType == MULTIFRONTAL_CHOLESKY)
-        || (linearSolverType == MULTIFRONTAL_QR);
+        || (linearSolverType == MULTIFRONTAL_QR)
+        || (linearSolverType == MULTIFRONTAL_CHOLESKY_MIXED);
   }
 
   inline bool isSequential() const {
@@ -153,6 +158,15 @@ public:
     case SEQUENTIAL_QR:
       return EliminateQR;
 
+    case MULTIFRONTAL_CHOLESKY_MIXED:
+      // As EliminatePreferCholesky, constrained noise models need QR
+      return [](const GaussianFactorGraph& factors, const Ordering& keys)
+                 -> std::pair<std::shared_ptr<GaussianConditional>,
+                              std::shared_ptr<GaussianFactor> > {
+        if (hasConstraints(factors)) return EliminateQR(factors, keys);
+        return EliminateCholeskySinglePrecision(factors, keys);
+      };
+
     default:
       throw std::runtime_error(
           "Nonlinear optimization parameter \"factorization\" is invalid");
@@ -19,6 +19,7 @@
 #include <gtsam/base/Testable.h>
 
 #include <string>
+#include <typeinfo>
 
 namespace gtsam {
 
@@ -73,6 +74,13 @@ namespace gtsam {
       return std::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    /// Linearize in place, see NonlinearFactor::linearizeInPlace.  Only this
+    /// exact type opts in, as derived classes may override linearize().
+    bool linearizeInPlace(const Values& x, GaussianFactor& factor) const override {
+      return typeid(*this) == typeid(This) &&
+             this->linearizeJacobianInPlace(x, factor);
+    }
+
     /** implement functions needed for Testable */
 
     /** print */
@@ -93,8 +93,8 @@ namespace gtsam {
   template <class ValueType>
   size_t Values::count() const {
     size_t i = 0;
-    for (const auto& [_, value] : values_) {
-      if (dynamic_cast<const GenericValue<ValueType>*>(value.get())) ++i;
+    for (const auto& [_, value] : *this) {
+      if (internal::genericValueCast<ValueType>(&value)) ++i;
     }
     return i;
   }
@@ -104,12 +104,11 @@ namespace gtsam {
   std::map<Key, ValueType>
   Values::extract(const std::function<bool(Key)>& filterFcn) const {
     std::map<Key, ValueType> result;
-    for (const auto& [key,value] : values_) {
+    for (const auto& [key,value] : *this) {
       // Check if key matches
       if (filterFcn(key)) {
         // Check if type matches (typically does as symbols matched with types)
-        if (auto t =
-                dynamic_cast<const GenericValue<ValueType>*>(value.get()))
+        if (auto t = internal::genericValueCast<ValueType>(&value))
           result[key] = t->value();
       }
     }
@@ -133,7 +132,7 @@ namespace gtsam {
    template <typename ValueType>
    struct handle {
      ValueType operator()(Key j, const Value* const pointer) {
-       auto ptr = dynamic_cast<const GenericValue<ValueType>*>(pointer);
+       auto ptr = genericValueCast<ValueType>(pointer);
        if (ptr) {
          // value returns a const ValueType&, and the return makes a copy !!!!!
          return ptr->value();
@@ -150,7 +149,7 @@ namespace gtsam {
    template <int M, int N>
    struct handle_matrix<Eigen::Matrix<double, M, N>, true> {
      inline Eigen::Matrix<double, M, N> operator()(Key j, const Value* const pointer) {
-       auto ptr = dynamic_cast<const GenericValue<Eigen::Matrix<double, M, N>>*>(pointer);
+       auto ptr = genericValueCast<Eigen::Matrix<double, M, N>>(pointer);
        if (ptr) {
          // value returns a const Matrix&, and the return makes a copy !!!!!
          return ptr->value();
@@ -165,7 +164,7 @@ namespace gtsam {
    template <int M, int N>
    struct handle_matrix<Eigen::Matrix<double, M, N>, false> {
      inline Eigen::Matrix<double, M, N> operator()(Key j, const Value* const pointer) {
-       auto ptr = dynamic_cast<const GenericValue<Eigen::Matrix<double, M, N>>*>(pointer);
+       auto ptr = genericValueCast<Eigen::Matrix<double, M, N>>(pointer);
        if (ptr) {
          // value returns a const MatrixMN&, and the return makes a copy !!!!!
          return ptr->value();
@@ -203,27 +202,26 @@ namespace gtsam {
    template <typename ValueType>
    const ValueType Values::at(Key j) const {
      // Find the item
-     KeyValueMap::const_iterator item = values_.find(j);
+     const Value* value = findValue(j);
 
      // Throw exception if it does not exist
-     if (item == values_.end()) throw ValuesKeyDoesNotExist("at", j);
+     if (!value) throw ValuesKeyDoesNotExist("at", j);
 
      // Check the type and throw exception if incorrect
      // h() split in two lines to avoid internal compiler error (MSVC2017)
      auto h = internal::handle<ValueType>();
-     return h(j, item->second.get());
+     return h(j, value);
   }
 
   /* ************************************************************************* */
   template<typename ValueType>
   const ValueType * Values::exists(Key j) const {
     // Find the item
-    KeyValueMap::const_iterator item = values_.find(j);
+    const Value* value = findValue(j);
 
-    if(item != values_.end()) {
-      const Value* value = item->second.get();
-      // dynamic cast the type and throw exception if incorrect
-      auto ptr = dynamic_cast<const GenericValue<ValueType>*>(value);
+    if(value) {
+      // cast the type and throw exception if incorrect
+      auto ptr = internal::genericValueCast<ValueType>(value);
       if (ptr) {
         return &ptr->value();
       } else {
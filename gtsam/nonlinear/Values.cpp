@@ -25,21 +25,125 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/VectorValues.h>
 
+#include <algorithm>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <new>
 #include <sstream>
 
 using namespace std;
 
 namespace gtsam {
 
+  /* ************************************************************************* */
+  namespace internal {
+
+  // Number of objects in the first block of a pool, later blocks double in
+  // size up to kMaxBlockCapacity objects.
+  static constexpr size_t kMinBlockCapacity = 16;
+  static constexpr size_t kMaxBlockCapacity = 4096;
+
+  /* ************************************************************************* */
+  ValuesArena::~ValuesArena() { clear(); }
+
+  /* ************************************************************************* */
+  void* ValuesArena::allocate(const Value& value) {
+    const size_t size = value.storageSize_();
+    if (size == 0) return nullptr;
+    Pool& pool = pools_[std::type_index(typeid(value))];
+    if (!pool.freeSlots.empty()) {
+      void* storage = pool.freeSlots.back();
+      pool.freeSlots.pop_back();
+      return storage;
+    }
+    if (pool.blocks.empty() || pool.used == pool.blocks.back().capacity) {
+      if (pool.blocks.empty()) {
+        pool.alignment = value.storageAlignment_();
+        pool.stride = (size + pool.alignment - 1) / pool.alignment * pool.alignment;
+      }
+      const size_t capacity =
+          pool.blocks.empty()
+              ? kMinBlockCapacity
+              : std::min(2 * pool.blocks.back().capacity, kMaxBlockCapacity);
+      char* data = static_cast<char*>(::operator new(
+          capacity * pool.stride, std::align_val_t(pool.alignment)));
+      pool.blocks.push_back({data, capacity});
+      pool.used = 0;
+    }
+    return pool.blocks.back().data + pool.stride * pool.used++;
+  }
+
+  /* ************************************************************************* */
+  Value* ValuesArena::clone(const Value& value) {
+    if (void* storage = allocate(value)) return value.cloneInto_(storage);
+    return value.clone_();
+  }
+
+  /* ************************************************************************* */
+  Value* ValuesArena::retract(const Value& value, const Vector& delta) {
+    if (void* storage = allocate(value)) return value.retractInto_(delta, storage);
+    return value.retract_(delta);
+  }
+
+  /* ************************************************************************* */
+  void ValuesArena::destroy(const Value* value) {
+    if (value->storageSize_() == 0) {
+      value->deallocate_();
+      return;
+    }
+    Pool& pool = pools_.at(std::type_index(typeid(*value)));
+    value->~Value();
+    pool.freeSlots.push_back(const_cast<Value*>(value));
+  }
+
+  /* ************************************************************************* */
+  void ValuesArena::clear() {
+    for (auto& [type, pool] : pools_)
+      for (const Block& block : pool.blocks)
+        ::operator delete(block.data, std::align_val_t(pool.alignment));
+    pools_.clear();
+  }
+
+  /* ************************************************************************* */
+  size_t ValuesArena::reservedBytes() const {
+    size_t bytes = 0;
+    for (const auto& [type, pool] : pools_)
+      for (const Block& block : pool.blocks) bytes += block.capacity * pool.stride;
+    return bytes;
+  }
+
+  /* ************************************************************************* */
+  std::unordered_map<std::type_index, size_t> ValuesArena::reservedBytesPerType() const {
+    std::unordered_map<std::type_index, size_t> bytes;
+    for (const auto& [type, pool] : pools_)
+      for (const Block& block : pool.blocks) bytes[type] += block.capacity * pool.stride;
+    return bytes;
+  }
+
+  }  // namespace internal
+
   /* ************************************************************************* */
   Values::Values(const Values& other) {
-    this->insert(other);
+    slots_.reserve(other.size());
+    for (const auto& [key, value] : other)
+      appendSlot(key, arena_.clone(value));
   }
 
   /* ************************************************************************* */
-  Values::Values(Values&& other) : values_(std::move(other.values_)) {
+  Values::Values(Values&& other)
+      : slots_(std::move(other.slots_)),
+        recent_(std::move(other.recent_)),
+        nrErased_(other.nrErased_),
+        arena_(std::move(other.arena_)) {
+    other.slots_.clear();
+    other.recent_.clear();
+    other.nrErased_ = 0;
+  }
+
+  /* ************************************************************************* */
+  Values::~Values() {
+    clear();
   }
 
   /* ************************************************************************* */
@@ -50,14 +154,14 @@ namespace gtsam {
 
   /* ************************************************************************* */
   Values::Values(const Values& other, const VectorValues& delta) {
-    for (const auto& [key,value] : other.values_) {
+    slots_.reserve(other.size());
+    for (const auto& [key, value] : other) {
       VectorValues::const_iterator it = delta.find(key);
       if (it != delta.end()) {
-        const Vector& v = it->second;
-        Value* retractedValue(value->retract_(v));  // Retract
-        values_.emplace(key, retractedValue);  // Add retracted result directly to result values
+        // Retract directly into the arena of the result values
+        appendSlot(key, arena_.retract(value, it->second));
       } else {
-        values_.emplace(key, value->clone_());  // Add original version to result values
+        appendSlot(key, arena_.clone(value));  // Add original version to result values
       }
     }
   }
@@ -66,9 +170,9 @@ namespace gtsam {
   void Values::print(const string& str, const KeyFormatter& keyFormatter) const {
     cout << str << (str.empty() ? "" : "\n");
     cout << "Values with " << size() << " values:\n";
-    for (const auto& [key,value] : values_) {
+    for (const auto& [key,value] : *this) {
       cout << "Value " << keyFormatter(key) << ": ";
-      value->print("");
+      value.print("");
       cout << "\n";
     }
   }
@@ -77,21 +181,124 @@ namespace gtsam {
   bool Values::equals(const Values& other, double tol) const {
     if (this->size() != other.size())
       return false;
-    for (auto it1 = values_.begin(), it2 = other.values_.begin();
-         it1 != values_.end(); ++it1, ++it2) {
-      const Value* value1 = it1->second.get();
-      const Value* value2 = it2->second.get();
-      if (typeid(*value1) != typeid(*value2) || it1->first != it2->first
-          || !value1->equals_(*value2, tol)) {
+    for (auto it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2) {
+      const Value& value1 = (*it1).value;
+      const Value& value2 = (*it2).value;
+      if (typeid(value1) != typeid(value2) || (*it1).key != (*it2).key
+          || !value1.equals_(value2, tol)) {
         return false;
       }
     }
     return true; // We return false earlier if we find anything that does not match
 }
 
+  /* ************************************************************************* */
+  namespace {
+  // Compare slots by key, for binary search in the sorted indices
+  template <typename SLOT>
+  bool slotKeyLess(const SLOT& slot, Key j) { return slot.key < j; }
+  template <typename SLOT>
+  bool keySlotLess(Key j, const SLOT& slot) { return j < slot.key; }
+  }  // namespace
+
+  /* ************************************************************************* */
+  const Value* Values::findValue(Key j) const {
+    for (const KeyValueSlots* slots : {&slots_, &recent_}) {
+      auto it = std::lower_bound(slots->begin(), slots->end(), j,
+                                 slotKeyLess<KeyValueSlot>);
+      if (it != slots->end() && it->key == j) return it->value;
+    }
+    return nullptr;
+  }
+
+  /* ************************************************************************* */
+  Value*& Values::findValue(Key j, const char* operation) {
+    for (KeyValueSlots* slots : {&slots_, &recent_}) {
+      auto it = std::lower_bound(slots->begin(), slots->end(), j,
+                                 slotKeyLess<KeyValueSlot>);
+      if (it != slots->end() && it->key == j && it->value) return it->value;
+    }
+    throw ValuesKeyDoesNotExist(operation, j);
+  }
+
+  /* ************************************************************************* */
+  void Values::insertSlot(Key j, Value* value) {
+    // Common case: keys arrive in increasing order
+    if (slots_.empty() || slots_.back().key < j) {
+      auto it = std::lower_bound(recent_.begin(), recent_.end(), j,
+                                 slotKeyLess<KeyValueSlot>);
+      if (it == recent_.end() || it->key != j) {
+        appendSlot(j, value);
+        return;
+      }
+    } else {
+      auto it = std::lower_bound(slots_.begin(), slots_.end(), j,
+                                 slotKeyLess<KeyValueSlot>);
+      if (it->key == j && !it->value) {
+        // Reinsertion of an erased key, reuse its tombstone
+        it->value = value;
+        --nrErased_;
+        return;
+      }
+      if (it->key != j) {
+        it = std::lower_bound(recent_.begin(), recent_.end(), j,
+                              slotKeyLess<KeyValueSlot>);
+        if (it == recent_.end() || it->key != j) {
+          recent_.insert(it, {j, value});
+          // Merge once the recent keys outnumber the square root of the size,
+          // which keeps the amortized cost of an insertion at O(sqrt(n)).
+          if (recent_.size() > 64 && recent_.size() * recent_.size() > slots_.size()) {
+            KeyValueSlots merged;
+            merged.reserve(slots_.size() + recent_.size());
+            std::merge(slots_.begin(), slots_.end(), recent_.begin(), recent_.end(),
+                       std::back_inserter(merged),
+                       [](const KeyValueSlot& a, const KeyValueSlot& b) {
+                         return a.key < b.key;
+                       });
+            slots_.swap(merged);
+            recent_.clear();
+          }
+          return;
+        }
+      }
+    }
+    arena_.destroy(value);
+    throw ValuesKeyAlreadyExists(j);
+  }
+
+  /* ************************************************************************* */
+  Values::deref_iterator Values::find(Key j) const {
+    auto it = std::lower_bound(slots_.begin(), slots_.end(), j,
+                               slotKeyLess<KeyValueSlot>);
+    auto recentIt = std::lower_bound(recent_.begin(), recent_.end(), j,
+                                     slotKeyLess<KeyValueSlot>);
+    if ((it != slots_.end() && it->key == j && it->value) ||
+        (recentIt != recent_.end() && recentIt->key == j))
+      return deref_iterator(it, slots_.end(), recentIt, recent_.end());
+    return end();
+  }
+
+  /* ************************************************************************* */
+  Values::deref_iterator Values::lower_bound(Key j) const {
+    return deref_iterator(
+        std::lower_bound(slots_.begin(), slots_.end(), j, slotKeyLess<KeyValueSlot>),
+        slots_.end(),
+        std::lower_bound(recent_.begin(), recent_.end(), j, slotKeyLess<KeyValueSlot>),
+        recent_.end());
+  }
+
+  /* ************************************************************************* */
+  Values::deref_iterator Values::upper_bound(Key j) const {
+    return deref_iterator(
+        std::upper_bound(slots_.begin(), slots_.end(), j, keySlotLess<KeyValueSlot>),
+        slots_.end(),
+        std::upper_bound(recent_.begin(), recent_.end(), j, keySlotLess<KeyValueSlot>),
+        recent_.end());
+  }
+
   /* ************************************************************************* */
   bool Values::exists(Key j) const {
-    return values_.find(j) != values_.end();
+    return findValue(j) != nullptr;
   }
 
   /* ************************************************************************* */
@@ -103,24 +310,16 @@ namespace gtsam {
   void Values::retractMasked(const VectorValues& delta, const KeySet& mask) {
     gttic(retractMasked);
     assert(this->size() == delta.size());
-    auto key_value = values_.begin();
-    VectorValues::const_iterator key_delta;
-#ifdef GTSAM_USE_TBB
-    for (; key_value != values_.end(); ++key_value) {
-      key_delta = delta.find(key_value->first);
-#else
-    for (key_delta = delta.begin(); key_value != values_.end();
-         ++key_value, ++key_delta) {
-      assert(key_value->first == key_delta->first);
-#endif
-      Key var = key_value->first;
-      assert(static_cast<size_t>(delta[var].size()) == key_value->second->dim());
-      assert(delta[var].allFinite());
-      if (mask.exists(var)) {
-        Value* retracted = key_value->second->retract_(delta[var]);
-        // TODO(dellaert): can we use std::move here?
-        *(key_value->second) = *retracted;
-        retracted->deallocate_();
+    for (KeyValueSlots* slots : {&slots_, &recent_}) {
+      for (KeyValueSlot& slot : *slots) {
+        if (!slot.value || !mask.exists(slot.key)) continue;
+        const Vector& d = delta.at(slot.key);
+        assert(static_cast<size_t>(d.size()) == slot.value->dim());
+        assert(d.allFinite());
+        // Assign in place so the value keeps its address
+        Value* retracted = arena_.retract(*slot.value, d);
+        *slot.value = *retracted;
+        arena_.destroy(retracted);
       }
     }
   }
@@ -130,61 +329,59 @@ namespace gtsam {
     if(this->size() != cp.size())
       throw DynamicValuesMismatched();
     VectorValues result;
-    for (auto it1 = values_.begin(), it2 = cp.values_.begin();
-         it1 != values_.end(); ++it1, ++it2) {
-      if(it1->first != it2->first)
+    for (auto it1 = begin(), it2 = cp.begin(); it1 != end(); ++it1, ++it2) {
+      const auto [key1, value1] = *it1;
+      const auto [key2, value2] = *it2;
+      if(key1 != key2)
         throw DynamicValuesMismatched(); // If keys do not match
       // Will throw a dynamic_cast exception if types do not match
       // NOTE: this is separate from localCoordinates(cp, ordering, result) due to at() vs. insert
-      result.insert(it1->first, it1->second->localCoordinates_(*it2->second));
+      result.insert(key1, value1.localCoordinates_(value2));
     }
     return result;
   }
 
   /* ************************************************************************* */
   const Value& Values::at(Key j) const {
-    KeyValueMap::const_iterator it = values_.find(j);
+    const Value* value = findValue(j);
 
     // Throw exception if it does not exist
-    if(it == values_.end())
+    if(!value)
       throw ValuesKeyDoesNotExist("retrieve", j);
-    return *it->second;
+    return *value;
   }
 
   /* ************************************************************************* */
   void Values::insert(Key j, const Value& val) {
-    auto insertResult = values_.emplace(j, val.clone_());
-    if(!insertResult.second)
-      throw ValuesKeyAlreadyExists(j);
+    insertSlot(j, arena_.clone(val));
   }
 
   /* ************************************************************************* */
   void Values::insert(const Values& other) {
-    for (const auto& [key, value] : other.values_) {
-      insert(key, *(value));
+    if (empty()) slots_.reserve(other.size());
+    for (const auto& [key, value] : other) {
+      insert(key, value);
     }
   }
 
   /* ************************************************************************* */
   void Values::update(Key j, const Value& val) {
     // Find the value to update
-    KeyValueMap::iterator it = values_.find(j);
-    if (it == values_.end())
-      throw ValuesKeyDoesNotExist("update", j);
+    Value*& value = findValue(j, "update");
 
     // Cast to the derived type
-    const Value& old_value = *it->second;
+    const Value& old_value = *value;
     if (typeid(old_value) != typeid(val))
       throw ValuesIncorrectType(j, typeid(old_value), typeid(val));
 
-    values_.erase(j);
-    values_.emplace(j, val.clone_());
+    arena_.destroy(value);
+    value = arena_.clone(val);
   }
 
   /* ************************************************************************* */
   void Values::update(const Values& other) {
-    for (auto& [key, value] : other.values_) {
-      this->update(key, *(value));
+    for (const auto& [key, value] : other) {
+      this->update(key, value);
     }
   }
 
@@ -201,24 +398,68 @@ namespace gtsam {
 
   /* ************************************************************************ */
   void Values::insert_or_assign(const Values& other) {
-    for (auto& [key, value] : other.values_) {
-      this->insert_or_assign(key, *(value));
+    for (const auto& [key, value] : other) {
+      this->insert_or_assign(key, value);
     }
   }
 
   /* ************************************************************************* */
   void Values::erase(Key j) {
-    KeyValueMap::iterator it = values_.find(j);
-    if(it == values_.end())
-      throw ValuesKeyDoesNotExist("erase", j);
-    values_.erase(it);
+    auto it = std::lower_bound(slots_.begin(), slots_.end(), j,
+                               slotKeyLess<KeyValueSlot>);
+    if (it != slots_.end() && it->key == j && it->value) {
+      // Leave a tombstone, and drop all of them once they fill half the index,
+      // so erasing is O(log n) amortized also when erasing the oldest keys.
+      arena_.destroy(it->value);
+      it->value = nullptr;
+      if (++nrErased_ > 16 && 2 * nrErased_ > slots_.size()) {
+        slots_.erase(std::remove_if(slots_.begin(), slots_.end(),
+                                    [](const KeyValueSlot& slot) { return !slot.value; }),
+                     slots_.end());
+        nrErased_ = 0;
+      }
+      return;
+    }
+    it = std::lower_bound(recent_.begin(), recent_.end(), j,
+                          slotKeyLess<KeyValueSlot>);
+    if (it != recent_.end() && it->key == j) {
+      arena_.destroy(it->value);
+      recent_.erase(it);
+      return;
+    }
+    throw ValuesKeyDoesNotExist("erase", j);
+  }
+
+  /* ************************************************************************* */
+  void Values::clear() {
+    for (const KeyValueSlot& slot : slots_)
+      if (slot.value) arena_.destroy(slot.value);
+    for (const KeyValueSlot& slot : recent_) arena_.destroy(slot.value);
+    slots_.clear();
+    recent_.clear();
+    nrErased_ = 0;
+    arena_.clear();
+  }
+
+  /* ************************************************************************* */
+  MemoryUsage Values::memoryUsage() const {
+    MemoryUsage usage;
+    usage.add("index", (slots_.capacity() + recent_.capacity()) * sizeof(KeyValueSlot));
+    static const std::string generic = "gtsam::GenericValue<";
+    for (const auto& [type, bytes] : arena_.reservedBytesPerType()) {
+      std::string name = demangle(type.name());
+      if (name.compare(0, generic.size(), generic) == 0 && name.back() == '>')
+        name = name.substr(generic.size(), name.size() - generic.size() - 1);
+      usage.add(name, bytes);
+    }
+    return usage;
   }
 
   /* ************************************************************************* */
   KeyVector Values::keys() const {
     KeyVector result;
     result.reserve(size());
-    for(const auto& [key,value]: values_)
+    for(const auto& [key,value]: *this)
       result.push_back(key);
     return result;
   }
@@ -226,23 +467,25 @@ namespace gtsam {
   /* ************************************************************************* */
   KeySet Values::keySet() const {
     KeySet result;
-    for(const auto& [key,value]: values_)
+    for(const auto& [key,value]: *this)
       result.insert(key);
     return result;
   }
 
   /* ************************************************************************* */
   Values& Values::operator=(const Values& rhs) {
-    this->clear();
-    this->insert(rhs);
+    if (this != &rhs) {
+      this->clear();
+      this->insert(rhs);
+    }
     return *this;
   }
 
   /* ************************************************************************* */
   size_t Values::dim() const {
     size_t result = 0;
-    for (const auto& [key,value] : values_) {
-      result += value->dim();
+    for (const auto& [key,value] : *this) {
+      result += value.dim();
     }
     return result;
   }
@@ -250,8 +493,8 @@ namespace gtsam {
   /* ************************************************************************* */
   std::map<Key,size_t> Values::dims() const {
     std::map<Key,size_t> result;
-    for (const auto& [key,value] : values_) {
-      result.emplace(key, value->dim());
+    for (const auto& [key,value] : *this) {
+      result.emplace(key, value.dim());
     }
     return result;
   }
@@ -259,8 +502,8 @@ namespace gtsam {
   /* ************************************************************************* */
   VectorValues Values::zeroVectors() const {
     VectorValues result;
-    for (const auto& [key,value] : values_)
-      result.insert(key, Vector::Zero(value->dim()));
+    for (const auto& [key,value] : *this)
+      result.insert(key, Vector::Zero(value.dim()));
     return result;
   }
 
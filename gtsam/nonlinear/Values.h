@@ -26,17 +26,23 @@
 
 #include <gtsam/inference/Key.h>
 #include <gtsam/base/FastDefaultAllocator.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/GenericValue.h>
 #include <gtsam/base/VectorSpace.h>
 
 #ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/unique_ptr.hpp>
 #endif
 
 
 #include <memory>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -53,6 +59,78 @@ namespace gtsam {
     ValueCloneAllocator() {}
   };
 
+  namespace internal {
+  /**
+   * Cast a Value to GenericValue<ValueType>, returning nullptr if the types
+   * do not match.  An exact type match is checked first, which avoids the
+   * cost of a dynamic_cast in the common case.
+   */
+  template <typename ValueType>
+  const GenericValue<ValueType>* genericValueCast(const Value* value) {
+    if (typeid(*value) == typeid(GenericValue<ValueType>))
+      return static_cast<const GenericValue<ValueType>*>(value);
+    return dynamic_cast<const GenericValue<ValueType>*>(value);
+  }
+
+  /**
+   * Storage for the Value objects held in a Values.  Values of the same
+   * concrete type are constructed in place in contiguous blocks, one pool per
+   * type, which avoids a heap allocation per variable and keeps variables of
+   * the same type close together in memory.  Blocks are never reallocated, so
+   * a value does not move once constructed.  Value types that do not support
+   * placement (Value::storageSize_() == 0) fall back to clone_().
+   */
+  class GTSAM_EXPORT ValuesArena {
+  public:
+    ValuesArena() = default;
+    ValuesArena(ValuesArena&& other) = default;
+    ValuesArena(const ValuesArena&) = delete;
+    ValuesArena& operator=(const ValuesArena&) = delete;
+    ~ValuesArena();
+
+    /// Copy a value into the arena
+    Value* clone(const Value& value);
+
+    /// Construct value.retract_(delta) in the arena
+    Value* retract(const Value& value, const Vector& delta);
+
+    /// Destroy a value created by clone() or retract()
+    void destroy(const Value* value);
+
+    /// Release all blocks, all values must have been destroyed
+    void clear();
+
+    /// Swap with another arena without moving any values
+    void swap(ValuesArena& other) { pools_.swap(other.pools_); }
+
+    /// Total number of bytes reserved for values in the arena
+    size_t reservedBytes() const;
+
+    /// Number of bytes reserved for values in the arena, per concrete value type
+    std::unordered_map<std::type_index, size_t> reservedBytesPerType() const;
+
+  private:
+    struct Block {
+      char* data;       ///< Aligned storage for `capacity` objects
+      size_t capacity;  ///< Number of objects that fit in this block
+    };
+
+    /// Blocks and free slots for one concrete value type
+    struct Pool {
+      size_t stride = 0;     ///< Size of one object, rounded up to alignment
+      size_t alignment = 0;  ///< Alignment of the blocks
+      size_t used = 0;       ///< Objects handed out from the last block
+      std::vector<Block> blocks;
+      std::vector<void*> freeSlots;
+    };
+
+    /// Return storage for a value of the same type as \c value, or nullptr
+    void* allocate(const Value& value);
+
+    std::unordered_map<std::type_index, Pool> pools_;
+  };
+  } // namespace internal
+
   /**
   * A non-templated config holding any types of Manifold-group elements.  A
   * values structure is a map from keys to values. It is used to specify the
@@ -65,18 +143,25 @@ namespace gtsam {
   class GTSAM_EXPORT Values {
 
   private:
-    // Internally we store a boost ptr_map, with a ValueCloneAllocator (defined
-    // below) to clone and deallocate the Value objects, and our compile-flag-
-    // dependent FastDefaultAllocator to allocate map nodes.  In this way, the
-    // user defines the allocation details (i.e. optimize for memory pool/arenas
-    // concurrency).
-    typedef internal::FastDefaultAllocator<typename std::pair<const Key, void*>>::type KeyValuePtrPairAllocator;
-    using KeyValueMap =
-        std::map<Key, std::unique_ptr<Value>, std::less<Key>,
-                 std::allocator<std::pair<const Key, std::unique_ptr<Value>>>>;
-
-    // The member to store the values, see just above
-    KeyValueMap values_;
+    // Internally we store a flat, sorted index from keys to values, where the
+    // values themselves live in an internal::ValuesArena that packs values of
+    // the same type contiguously.  Keys inserted out of order go to a second,
+    // small sorted index, which is merged into the main one when it grows
+    // beyond roughly the square root of the total size.  Iteration merges the
+    // two, so the observable order is always the sorted key order.  Erasing a
+    // key from the main index leaves a tombstone, a slot without value, which
+    // is skipped by iteration and removed once tombstones make up half of it.
+    struct KeyValueSlot {
+      Key key;       ///< The key
+      Value* value;  ///< The value, owned by arena_
+    };
+    using KeyValueSlots = std::vector<KeyValueSlot>;
+
+    // The members storing the values, see just above
+    KeyValueSlots slots_;   ///< Sorted index, appended to in key order
+    KeyValueSlots recent_;  ///< Sorted index of keys inserted out of order
+    size_t nrErased_ = 0;   ///< Number of tombstones in slots_
+    internal::ValuesArena arena_;
 
   public:
 
@@ -116,6 +201,9 @@ namespace gtsam {
 
     /** Move constructor */
     Values(Values&& other);
+
+    /** Destructor */
+    ~Values();
     
     /** Constructor from initializer list. Example usage:
      * \code
@@ -175,45 +263,71 @@ namespace gtsam {
     const ValueType * exists(Key j) const;
 
     /** The number of variables in this config */
-    size_t size() const { return values_.size(); }
+    size_t size() const { return slots_.size() - nrErased_ + recent_.size(); }
 
     /** whether the config is empty */
-    bool empty() const { return values_.empty(); }
+    bool empty() const { return size() == 0; }
 
     /// @}
     /// @name Iterator
     /// @{
 
+    /// Iterates over the key-value pairs in key order, merging the two
+    /// sorted indices.
     struct deref_iterator {
-      using const_iterator_type = typename KeyValueMap::const_iterator;
-      const_iterator_type it_;
-      deref_iterator(const_iterator_type it) : it_(it) {}
-      ConstKeyValuePair operator*() const { return {it_->first, *(it_->second)}; }
+      using slot_iterator = typename KeyValueSlots::const_iterator;
+      slot_iterator it_, end_;              // in the main index
+      slot_iterator recentIt_, recentEnd_;  // in the index of recent inserts
+      deref_iterator(slot_iterator it, slot_iterator end,
+                     slot_iterator recentIt, slot_iterator recentEnd)
+          : it_(it), end_(end), recentIt_(recentIt), recentEnd_(recentEnd) {
+        skipErased();
+      }
+      /// Skip the tombstones of erased keys in the main index
+      void skipErased() {
+        while (it_ != end_ && !it_->value) ++it_;
+      }
+      /// Whether the current element comes from the main index
+      bool inMain() const {
+        return recentIt_ == recentEnd_ ||
+               (it_ != end_ && it_->key < recentIt_->key);
+      }
+      const KeyValueSlot& slot() const { return inMain() ? *it_ : *recentIt_; }
+      ConstKeyValuePair operator*() const { return {slot().key, *slot().value}; }
       std::unique_ptr<ConstKeyValuePair> operator->() {
-        return std::make_unique<ConstKeyValuePair>(it_->first, *(it_->second));
+        return std::make_unique<ConstKeyValuePair>(slot().key, *slot().value);
       }
       bool operator==(const deref_iterator& other) const {
-        return it_ == other.it_;
+        return it_ == other.it_ && recentIt_ == other.recentIt_;
       }
-      bool operator!=(const deref_iterator& other) const { return it_ != other.it_; }
+      bool operator!=(const deref_iterator& other) const { return !(*this == other); }
       deref_iterator& operator++() {
-        ++it_;
+        if (inMain()) {
+          ++it_;
+          skipErased();
+        } else {
+          ++recentIt_;
+        }
         return *this;
       }
     };
 
-    deref_iterator begin() const { return deref_iterator(values_.begin()); }
-    deref_iterator end() const { return deref_iterator(values_.end()); }
+    deref_iterator begin() const {
+      return deref_iterator(slots_.begin(), slots_.end(), recent_.begin(), recent_.end());
+    }
+    deref_iterator end() const {
+      return deref_iterator(slots_.end(), slots_.end(), recent_.end(), recent_.end());
+    }
 
     /** Find an element by key, returning an iterator, or end() if the key was
      * not found. */
-    deref_iterator find(Key j) const { return deref_iterator(values_.find(j)); }
+    deref_iterator find(Key j) const;
 
     /** Find the element greater than or equal to the specified key. */
-    deref_iterator lower_bound(Key j) const { return deref_iterator(values_.lower_bound(j)); }
+    deref_iterator lower_bound(Key j) const;
     
     /** Find the lowest-ordered element greater than the specified key. */
-    deref_iterator upper_bound(Key j) const { return deref_iterator(values_.upper_bound(j)); }
+    deref_iterator upper_bound(Key j) const;
 
     /// @}
     /// @name Manifold Operations
@@ -292,10 +406,22 @@ namespace gtsam {
     Values& operator=(const Values& rhs);
 
     /** Swap the contents of two Values without copying data */
-    void swap(Values& other) { values_.swap(other.values_); }
+    void swap(Values& other) {
+      slots_.swap(other.slots_);
+      recent_.swap(other.recent_);
+      std::swap(nrErased_, other.nrErased_);
+      arena_.swap(other.arena_);
+    }
 
     /** Remove all variables from the config */
-    void clear() { values_.clear(); }
+    void clear();
+
+    /**
+     * Bytes used by this Values: the key index as "index", and the storage
+     * reserved for each value type, named after the type, e.g. "gtsam::Pose3".
+     * Cheap, the cost is linear in the number of value types.
+     */
+    MemoryUsage memoryUsage() const;
 
     /** Compute the total dimensionality of all values (\f$ O(n) \f$) */
     size_t dim() const;
@@ -341,16 +467,43 @@ namespace gtsam {
       // static_assert if ValueType is type: Value
       static_assert(!std::is_same<Value, ValueType>::value, "ValueType must not be type: Value to use this filter");
       // Filter and check the type
-      return filter(key_value.key) && (dynamic_cast<const GenericValue<ValueType>*>(&key_value.value));
+      return filter(key_value.key) && internal::genericValueCast<ValueType>(&key_value.value);
     }
 
+    /// Return the value stored with key \c j, or nullptr if there is none
+    const Value* findValue(Key j) const;
+
+    /// Mutable version of findValue
+    Value*& findValue(Key j, const char* operation);
+
+    /// Add a value that was already constructed in arena_ to the index
+    void insertSlot(Key j, Value* value);
+
+    /// Add a key/value pair, with a key greater than all existing keys
+    void appendSlot(Key j, Value* value) { slots_.push_back({j, value}); }
+
 #ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
     /** Serialization function */
     friend class boost::serialization::access;
+    // Serialized through the map of owning pointers Values used to store, so
+    // archives keep their format.
+    using SerializedMap = std::map<Key, std::unique_ptr<Value>>;
+    template<class ARCHIVE>
+    void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+      SerializedMap values_;
+      for (const auto& [key, value] : *this)
+        values_.emplace(key, std::unique_ptr<Value>(value.clone_()));
+      ar << BOOST_SERIALIZATION_NVP(values_);
+    }
     template<class ARCHIVE>
-    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
-      ar & BOOST_SERIALIZATION_NVP(values_);
+    void load(ARCHIVE & ar, const unsigned int /*version*/) {
+      SerializedMap values_;
+      ar >> BOOST_SERIALIZATION_NVP(values_);
+      clear();
+      for (const auto& [key, value] : values_)
+        appendSlot(key, arena_.clone(*value));
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 #endif
 
   };
@@ -25,6 +25,7 @@
 #include <gtsam/base/TestableAssertions.h>
 
 #include <CppUnitLite/TestHarness.h>
+#include <algorithm>
 #include <stdexcept>
 #include <limits>
 #include <type_traits>
@@ -220,6 +221,91 @@ TEST(Values, basic_functions)
   EXPECT_LONGS_EQUAL(4, values.upper_bound(3)->key);
 }
 
+/* ************************************************************************* */
+TEST(Values, insert_out_of_order)
+{
+  // Interleave poses and landmarks, so landmarks are inserted out of key order
+  Values values;
+  const size_t n = 500;
+  for (size_t i = 0; i < n; i++) {
+    values.insert(X(i), Pose2(double(i), 0.0, 0.0));
+    values.insert(L(n - 1 - i), Point2(double(i), 0.0));
+  }
+  LONGS_EQUAL(2 * n, values.size());
+
+  // Iteration is in key order
+  const KeyVector keys = values.keys();
+  EXPECT(std::is_sorted(keys.begin(), keys.end()));
+  size_t count = 0;
+  Key previous = 0;
+  for (const auto& [key, value] : values) {
+    if (count++ > 0) EXPECT(previous < key);
+    previous = key;
+  }
+  EXPECT_LONGS_EQUAL(2 * n, count);
+
+  // Lookups in both the poses and landmarks
+  EXPECT(assert_equal(Pose2(7.0, 0.0, 0.0), values.at<Pose2>(X(7))));
+  EXPECT(assert_equal(Point2(7.0, 0.0), values.at<Point2>(L(n - 8))));
+  EXPECT_LONGS_EQUAL(L(3), values.find(L(3))->key);
+  EXPECT_LONGS_EQUAL(X(0), values.upper_bound(L(n - 1))->key);
+  EXPECT(values.find(L(n)) == values.end());
+  CHECK_EXCEPTION(values.insert(L(3), Point2(0.0, 0.0)), ValuesKeyAlreadyExists);
+
+  // Erase from both and check the copy is identical
+  values.erase(L(3));
+  values.erase(X(3));
+  EXPECT(!values.exists(L(3)));
+  EXPECT(!values.exists(X(3)));
+  Values copy(values);
+  EXPECT(assert_equal(values, copy));
+  EXPECT_LONGS_EQUAL(n - 1, copy.count<Pose2>());
+}
+
+/* ************************************************************************* */
+TEST(Values, erase_sliding_window)
+{
+  // Fixed-lag pattern: insert the newest key and erase the oldest one
+  Values values;
+  const size_t lag = 50;
+  for (size_t i = 0; i < 1000; i++) {
+    values.insert(X(i), Pose2(double(i), 0.0, 0.0));
+    if (i >= lag) values.erase(X(i - lag));
+    EXPECT_LONGS_EQUAL(std::min(i + 1, lag), values.size());
+  }
+  EXPECT(!values.exists(X(949)));
+  CHECK_EXCEPTION(values.at(X(949)), ValuesKeyDoesNotExist);
+  CHECK_EXCEPTION(values.erase(X(949)), ValuesKeyDoesNotExist);
+  EXPECT(values.find(X(949)) == values.end());
+  EXPECT_LONGS_EQUAL(X(950), values.begin()->key);
+  EXPECT_LONGS_EQUAL(X(950), values.lower_bound(X(900))->key);
+  EXPECT_LONGS_EQUAL(lag, values.keys().size());
+
+  // Erased keys can be inserted again
+  values.erase(X(960));
+  values.insert(X(960), Pose2(1.0, 2.0, 3.0));
+  EXPECT(assert_equal(Pose2(1.0, 2.0, 3.0), values.at<Pose2>(X(960))));
+  EXPECT_LONGS_EQUAL(lag, values.size());
+  Values copy(values);
+  EXPECT(assert_equal(values, copy));
+}
+
+/* ************************************************************************* */
+TEST(Values, value_address_stable)
+{
+  // Values do not move when more values are inserted or retracted in place
+  Values values;
+  values.insert(X(1), Pose2(1.0, 2.0, 0.3));
+  const Pose2* pose = values.exists<Pose2>(X(1));
+  for (size_t i = 2; i < 1000; i++) values.insert(X(i), Pose2());
+  EXPECT(pose == values.exists<Pose2>(X(1)));
+
+  const VectorValues delta = values.zeroVectors();
+  values.retractMasked(delta, KeySet{X(1)});
+  EXPECT(pose == values.exists<Pose2>(X(1)));
+  EXPECT(assert_equal(Pose2(1.0, 2.0, 0.3), *pose));
+}
+
 /* ************************************************************************* */
 TEST(Values, retract_full)
 {
@@ -570,6 +656,23 @@ TEST(Values, Demangle) {
   EXPECT(assert_print_equal(expected, values));
 }
 
+/* ************************************************************************* */
+TEST(Values, memoryUsage) {
+  Values values;
+  values.insert(key1, Pose2());
+  values.insert(key2, Pose3());
+  values.insert(key3, Pose2());
+
+  const MemoryUsage usage = values.memoryUsage();
+  EXPECT_LONGS_EQUAL(3, usage.components().size());
+  EXPECT(usage.bytes("gtsam::Pose2") >= 2 * sizeof(GenericValue<Pose2>));
+  EXPECT(usage.bytes("gtsam::Pose3") >= sizeof(GenericValue<Pose3>));
+  EXPECT(usage.bytes("index") >= 3 * sizeof(std::pair<Key, Value*>));
+  EXPECT_LONGS_EQUAL(usage.bytes("gtsam::Pose2") + usage.bytes("gtsam::Pose3") +
+                         usage.bytes("index"),
+                     usage.total());
+}
+
 /* ************************************************************************* */
 TEST(Values, brace_initializer) {
   const Pose2 poseA(1.0, 2.0, 0.3), poseC(.0, .0, .0);
@@ -16,9 +16,13 @@
 #pragma once
 
 #include <ostream>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
+#include <gtsam/linear/JacobianBatch.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 
 #ifdef _WIN32
@@ -83,6 +87,13 @@ namespace gtsam {
       return std::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    /// Linearize in place, see NonlinearFactor::linearizeInPlace.  Only this
+    /// exact type opts in, as derived classes may override linearize().
+    bool linearizeInPlace(const Values& x, GaussianFactor& factor) const override {
+      return typeid(*this) == typeid(This) &&
+             this->linearizeJacobianInPlace(x, factor);
+    }
+
     /// @name Testable
     /// @{
 
@@ -131,6 +142,62 @@ namespace gtsam {
     const VALUE& measured() const {
       return measured_;
     }
+
+    /**
+     * Linearize a batch of factors into the contiguous storage of \c batch,
+     * with the same result as linearize() for each of them.  The Jacobians are
+     * evaluated as fixed-size matrices straight into the buffer, without a
+     * virtual call or an allocation per factor; only factors with a robust
+     * noise model go through linearize().  Throws std::invalid_argument for
+     * constrained noise models, whose linearization is not whitened.
+     */
+    static void LinearizeBatch(const std::vector<const This*>& factors,
+                               const Values& x, JacobianBatch& batch) {
+      constexpr int D = traits<T>::dimension;
+      static_assert(D != Eigen::Dynamic,
+                    "LinearizeBatch needs values of fixed dimension");
+      batch.reset(D, {D, D}, factors.size());
+      typename traits<T>::ChartJacobian::Jacobian H1, H2;
+      const noiseModel::Base* lastModel = nullptr;
+      const noiseModel::Gaussian* gaussian = nullptr;
+      for (size_t k = 0; k < factors.size(); ++k) {
+        const This& factor = *factors[k];
+        batch.key(k, 0) = factor.key1();
+        batch.key(k, 1) = factor.key2();
+
+        // Factors of one graph usually share few noise models
+        const noiseModel::Base* model = factor.noiseModel().get();
+        if (model != lastModel) {
+          if (model && model->isConstrained())
+            throw std::invalid_argument(
+                "BetweenFactor::LinearizeBatch: constrained noise models are "
+                "not supported");
+          gaussian = dynamic_cast<const noiseModel::Gaussian*>(model);
+          lastModel = model;
+        }
+        if (model && !gaussian) {
+          // Robust models reweight the system by the error
+          const auto jacobian =
+              std::static_pointer_cast<JacobianFactor>(factor.linearize(x));
+          batch.Ab(k) = jacobian->matrixObject().matrix();
+          continue;
+        }
+
+        const T hx = traits<T>::Between(x.at<T>(factor.key1()),
+                                        x.at<T>(factor.key2()), H1, H2);
+#ifdef GTSAM_SLOW_BUT_CORRECT_BETWEENFACTOR
+        typename traits<T>::ChartJacobian::Jacobian Hlocal;
+        batch.b(k) = -traits<T>::Local(factor.measured_, hx, OptionalNone, Hlocal);
+        batch.A(k, 0) = Hlocal * H1;
+        batch.A(k, 1) = Hlocal * H2;
+#else
+        batch.b(k) = -traits<T>::Local(factor.measured_, hx);
+        batch.A(k, 0) = H1;
+        batch.A(k, 1) = H2;
+#endif
+        if (gaussian) gaussian->WhitenInPlace(batch.Ab(k));
+      }
+    }
     /// @}
 
   private:
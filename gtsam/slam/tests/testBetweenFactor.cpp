@@ -113,6 +113,45 @@ TEST(BetweenFactor, Pose3Jacobians) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 }
 
+/* ************************************************************************* */
+TEST(BetweenFactor, LinearizeBatch) {
+  Values values;
+  for (size_t i = 0; i < 4; ++i)
+    values.insert(X(i), Pose3(Rot3::Rodrigues(0.1 * i, -0.2, 0.3 * i),
+                              Point3(i, 0.5 * i, -1.0)));
+
+  const Pose3 measured(Rot3::Rodrigues(0.1, 0.0, 0.2), Point3(1, 0.4, 0));
+  Matrix6 covariance = Matrix6::Identity() * 0.04;
+  covariance(0, 1) = covariance(1, 0) = 0.01;
+  const SharedNoiseModel models[] = {
+      Isotropic::Sigma(6, 0.1), Isotropic::Sigma(6, 0.1),
+      Gaussian::Covariance(covariance), Unit::Create(6),
+      Robust::Create(mEstimator::Huber::Create(0.1), Isotropic::Sigma(6, 0.1))};
+
+  std::vector<BetweenFactor<Pose3>> factors;
+  for (size_t k = 0; k < 5; ++k)
+    factors.emplace_back(X(k % 4), X((k + 1) % 4), measured, models[k]);
+  std::vector<const BetweenFactor<Pose3>*> batch;
+  for (const auto& factor : factors) batch.push_back(&factor);
+
+  JacobianBatch jacobians;
+  BetweenFactor<Pose3>::LinearizeBatch(batch, values, jacobians);
+  LONGS_EQUAL(5, jacobians.size());
+  for (size_t k = 0; k < factors.size(); ++k) {
+    const auto expected = std::dynamic_pointer_cast<JacobianFactor>(
+        factors[k].linearize(values));
+    CHECK(expected);
+    EXPECT(assert_equal(*expected, *jacobians.jacobianFactor(k), 1e-9));
+  }
+
+  // Constrained noise models are not whitened by linearize
+  const BetweenFactor<Pose3> constrained(X(0), X(1), measured,
+                                         Constrained::All(6));
+  CHECK_EXCEPTION(BetweenFactor<Pose3>::LinearizeBatch({&constrained}, values,
+                                                       jacobians),
+                  std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -19,6 +19,7 @@
 #include <gtsam/inference/VariableIndex.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/serializationTestHelpers.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -139,6 +140,64 @@ TEST(VariableIndex, deep_copy) {
   EXPECT(assert_equal(expectedRemoved, clone));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, incremental) {
+  // Grow a chain one factor at a time, as iSAM2 does, and remove half of it
+  SymbolicFactorGraph graph;
+  VariableIndex actual;
+  for (size_t i = 0; i < 100; ++i) {
+    SymbolicFactorGraph newFactors;
+    newFactors.push_factor(i, i + 1);
+    newFactors.push_factor(i % 7, i + 1);
+    actual.augment(newFactors);
+    graph.push_back(newFactors);
+  }
+  EXPECT(assert_equal(VariableIndex(graph), actual));
+  EXPECT_LONGS_EQUAL(400, actual.nEntries());
+
+  // Factors keep their order within a row, and variable order is key order
+  const VariableIndex::Factors factors = actual[3];
+  EXPECT_LONGS_EQUAL(17, factors.size());
+  EXPECT(std::is_sorted(factors.begin(), factors.end()));
+  KeyVector keys;
+  for (const auto& [key, _] : actual) keys.push_back(key);
+  EXPECT_LONGS_EQUAL(101, keys.size());
+  EXPECT(std::is_sorted(keys.begin(), keys.end()));
+
+  // Remove the second factor of every step
+  SymbolicFactorGraph removed;
+  vector<size_t> indices;
+  for (size_t i = 0; i < 100; ++i) {
+    indices.push_back(2 * i + 1);
+    removed.push_back(graph[2 * i + 1]);
+    graph.remove(2 * i + 1);
+  }
+  actual.remove(indices.begin(), indices.end(), removed);
+  EXPECT(assert_equal(VariableIndex(graph), actual));
+  EXPECT_LONGS_EQUAL(200, actual.nEntries());
+
+  // Compacting keeps the contents but shrinks the storage
+  const size_t capacity = actual.capacity();
+  actual.compact();
+  EXPECT(assert_equal(VariableIndex(graph), actual));
+  EXPECT(actual.capacity() < capacity);
+  EXPECT(actual.capacity() <= 2 * actual.nEntries() + actual.size());
+}
+
+#ifdef GTSAM_ENABLE_BOOST_SERIALIZATION
+/* ************************************************************************* */
+TEST(VariableIndex, serialization) {
+  const VariableIndex index(testGraph1());
+  EXPECT(serializationTestHelpers::equalsObj(index));
+  EXPECT(serializationTestHelpers::equalsXML(index));
+  EXPECT(serializationTestHelpers::equalsBinary(index));
+
+  // Archives keep the element name of the former per-variable map
+  const string xml = serializeXML(index);
+  EXPECT(xml.find("<index_") != string::npos);
+}
+#endif
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
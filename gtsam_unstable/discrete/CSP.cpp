@@ -22,7 +22,7 @@ bool CSP::runArcConsistency(const VariableIndex& index,
   for (auto entry : index) {
     // Get the variable's key and associated factors:
     const Key key = entry.first;
-    const FactorIndices& factors = entry.second;
+    const VariableIndex::Factors factors = entry.second;
 
     // If this domain is already a singleton, we do nothing.
     if (domains->at(key).isSingleton()) continue;
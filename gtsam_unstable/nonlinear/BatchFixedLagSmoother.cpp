@@ -178,7 +178,10 @@ void BatchFixedLagSmoother::eraseKeys(const KeyVector& keys) {
 /* ************************************************************************* */
 void BatchFixedLagSmoother::reorder(const KeyVector& marginalizeKeys) {
   // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
-  ordering_ = Ordering::ColamdConstrainedFirst(factors_, marginalizeKeys);
+  FastMap<Key, int> groups;
+  for (const auto& key_value : theta_) groups.emplace(key_value.key, 1);
+  for (Key key : marginalizeKeys) groups[key] = 0;
+  ordering_ = orderingCache_.ordering(factors_, groups);
 }
 
 /* ************************************************************************* */
@@ -245,8 +248,13 @@ FixedLagSmoother::Result BatchFixedLagSmoother::optimize() {
 
         gttic(solve);
         // Solve Damped Gaussian Factor Graph
-        newDelta = dampedFactorGraph.optimize(ordering_,
-            parameters_.getEliminationFunction());
+        if (!structure_ || structure_->ordering() != ordering_ ||
+            !structure_->matches(dampedFactorGraph))
+          structure_ = std::make_shared<GaussianJunctionTree::Structure>(
+              dampedFactorGraph, ordering_);
+        newDelta = GaussianJunctionTree(dampedFactorGraph, *structure_)
+                       .eliminate(parameters_.getEliminationFunction())
+                       .first->optimize();
         // update the evalpoint with the new delta
         evalpoint = theta_.retract(newDelta);
         gttoc(solve);
@@ -22,6 +22,7 @@
 
 #include <gtsam_unstable/nonlinear/FixedLagSmoother.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/inference/OrderingCache.h>
 #include <queue>
 
 namespace gtsam {
@@ -142,6 +143,12 @@ protected:
   /** The current ordering */
   Ordering ordering_;
 
+  /** Orderings of recent graph topologies, a repeated window is not ordered again */
+  OrderingCache orderingCache_;
+
+  /** Junction tree structure of the damped system, re-used while the topology does not change */
+  std::shared_ptr<GaussianJunctionTree::Structure> structure_;
+
   /** The current set of linear deltas */
   VectorValues delta_;
 
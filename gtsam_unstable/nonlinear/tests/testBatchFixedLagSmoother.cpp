@@ -237,6 +237,70 @@ TEST( BatchFixedLagSmoother, Example )
   }
 }
 
+/* ************************************************************************* */
+namespace {
+// Clears the ordering cache and the junction tree structure before every
+// update when caching is off, and exposes the cache statistics
+class CachingSmoother : public BatchFixedLagSmoother {
+ public:
+  CachingSmoother(double smootherLag, bool useCache)
+      : BatchFixedLagSmoother(smootherLag), useCache_(useCache) {}
+
+  Result update(const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+                const Values& newTheta = Values(),
+                const KeyTimestampMap& timestamps = KeyTimestampMap(),
+                const FactorIndices& factorsToRemove = FactorIndices()) override {
+    if (!useCache_) {
+      orderingCache_.clear();
+      structure_.reset();
+    }
+    return BatchFixedLagSmoother::update(newFactors, newTheta, timestamps,
+                                         factorsToRemove);
+  }
+
+  size_t nrOrderingHits() const { return orderingCache_.nrHits(); }
+
+ private:
+  bool useCache_;
+};
+}  // namespace
+
+/* ************************************************************************* */
+TEST( BatchFixedLagSmoother, CachedStructure )
+{
+  SharedDiagonal odometerNoise = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1));
+  CachingSmoother cached(5.0, true), uncached(5.0, false);
+
+  // A chain of points with loop closures, and repeated updates without new
+  // factors, which see the same topology again
+  for (size_t i = 0; i < 15; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    FixedLagSmoother::KeyTimestampMap newTimestamps;
+    if (i == 0)
+      newFactors.addPrior(Key(0), Point2(0.0, 0.0), odometerNoise);
+    else
+      newFactors.push_back(BetweenFactor<Point2>(Key(i - 1), Key(i),
+                                                 Point2(1.0, 0.0), odometerNoise));
+    if (i % 4 == 3)
+      newFactors.push_back(BetweenFactor<Point2>(Key(i - 3), Key(i),
+                                                 Point2(3.0, 0.0), odometerNoise));
+    newValues.insert(Key(i), Point2(double(i) + 0.1, -0.1 * (i % 3)));
+    newTimestamps[Key(i)] = double(i);
+
+    cached.update(newFactors, newValues, newTimestamps);
+    uncached.update(newFactors, newValues, newTimestamps);
+    for (size_t j = 0; j < 2; ++j) {
+      cached.update();
+      uncached.update();
+    }
+    EXPECT(assert_equal(uncached.calculateEstimate(),
+                        cached.calculateEstimate(), 1e-6));
+  }
+  EXPECT(cached.nrOrderingHits() >= 15);
+  EXPECT_LONGS_EQUAL(0, uncached.nrOrderingHits());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testAsyncISAM2.cpp
+ * @brief   Unit tests for the asynchronous ISAM2 front end
+ */
+
+#include <gtsam/nonlinear/AsyncISAM2.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+namespace {
+const SharedNoiseModel kNoise = noiseModel::Isotropic::Sigma(3, 0.1);
+const Pose2 kOdometry(1.0, 0.0, 0.1);
+}  // namespace
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, sameAsISAM2) {
+  ISAM2 isam;
+  AsyncISAM2 async;
+  EXPECT(!async.estimate());
+
+  vector<future<ISAM2Result> > results;
+  Pose2 pose;
+  for (size_t i = 0; i < 10; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+    if (i == 0) {
+      newFactors.addPrior(X(0), pose, kNoise);
+    } else {
+      newFactors.emplace_shared<BetweenFactor<Pose2> >(X(i - 1), X(i),
+                                                       kOdometry, kNoise);
+      pose = pose * kOdometry;
+    }
+    if (i == 9)  // loop closure
+      newFactors.emplace_shared<BetweenFactor<Pose2> >(X(0), X(9), pose,
+                                                       kNoise);
+    newTheta.insert(X(i), pose.retract(Vector3(0.05, -0.05, 0.01)));
+    isam.update(newFactors, newTheta);
+    results.push_back(async.update(newFactors, newTheta));
+
+    // Reading never requires the update to have finished
+    const AsyncISAM2::Snapshot snapshot = async.estimate();
+    if (snapshot) {
+      EXPECT(snapshot->size() <= i + 1);
+    }
+  }
+
+  for (size_t i = 0; i < results.size(); ++i)
+    EXPECT_LONGS_EQUAL(i == 0 ? 1 : (i == 9 ? 2 : 1),
+                       results[i].get().newFactorsIndices.size());
+  async.waitForUpdates();
+  EXPECT_LONGS_EQUAL(10, async.nrCompletedUpdates());
+  EXPECT_LONGS_EQUAL(0, async.nrPendingUpdates());
+
+  const AsyncISAM2::Snapshot snapshot = async.estimate();
+  CHECK(snapshot);
+  EXPECT(assert_equal(isam.calculateEstimate(), *snapshot));
+  EXPECT_LONGS_EQUAL(
+      11, async.withISAM2([](const ISAM2& internal) {
+        return internal.getFactorsUnsafe().size();
+      }));
+
+  // A held snapshot is not modified by later updates
+  NonlinearFactorGraph newFactors;
+  newFactors.addPrior(X(5), Pose2(), kNoise);
+  async.update(newFactors).get();
+  EXPECT(assert_equal(isam.calculateEstimate(), *snapshot));
+  EXPECT(async.estimate() != snapshot);
+}
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, exception) {
+  AsyncISAM2 async;
+  NonlinearFactorGraph newFactors;
+  newFactors.addPrior(X(0), Pose2(), kNoise);
+  Values newTheta;
+  newTheta.insert(X(0), Pose2());
+  async.update(newFactors, newTheta);
+
+  // X(0) is already in the system, the error is reported through the future
+  future<ISAM2Result> failed = async.update(NonlinearFactorGraph(), newTheta);
+  CHECK_EXCEPTION(failed.get(), ValuesKeyAlreadyExists);
+
+  // The worker keeps running after a failed update
+  newFactors = NonlinearFactorGraph();
+  newFactors.emplace_shared<BetweenFactor<Pose2> >(X(0), X(1), kOdometry,
+                                                   kNoise);
+  newTheta = Values();
+  newTheta.insert(X(1), kOdometry);
+  async.update(newFactors, newTheta);
+  async.waitForUpdates();
+  EXPECT_LONGS_EQUAL(3, async.nrCompletedUpdates());
+  CHECK(async.estimate());
+  EXPECT(assert_equal(kOdometry, async.estimate()->at<Pose2>(X(1))));
+}
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, withISAM2DoesNotBlockQueueing) {
+  AsyncISAM2 async;
+  NonlinearFactorGraph newFactors;
+  newFactors.addPrior(X(0), Pose2(), kNoise);
+  Values newTheta;
+  newTheta.insert(X(0), Pose2());
+  async.update(newFactors, newTheta);
+
+  // Queueing and reading work while the function runs, the queued update is
+  // only applied after it returned
+  future<ISAM2Result> result;
+  const size_t nrFactors = async.withISAM2([&](const ISAM2& isam) {
+    NonlinearFactorGraph between;
+    between.emplace_shared<BetweenFactor<Pose2> >(X(0), X(1), kOdometry,
+                                                  kNoise);
+    Values theta;
+    theta.insert(X(1), kOdometry);
+    result = async.update(between, theta);
+    EXPECT(async.estimate());
+    EXPECT_LONGS_EQUAL(1, async.nrPendingUpdates());
+    return isam.getFactorsUnsafe().size();
+  });
+  EXPECT_LONGS_EQUAL(1, nrFactors);
+  EXPECT_LONGS_EQUAL(1, result.get().newFactorsIndices.size());
+  async.waitForUpdates();
+  EXPECT(assert_equal(kOdometry, async.estimate()->at<Pose2>(X(1))));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
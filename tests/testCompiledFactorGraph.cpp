@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testCompiledFactorGraph.cpp
+ * @brief   Unit tests for CompiledFactorGraph and the optimizers using it
+ */
+
+#include <gtsam/nonlinear/CompiledFactorGraph.h>
+#include <gtsam/nonlinear/DoglegOptimizer.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+namespace {
+const SharedNoiseModel kNoise = noiseModel::Isotropic::Sigma(3, 0.1);
+
+// A loop of poses with a prior, and a perturbed initial estimate
+NonlinearFactorGraph createLoop(Values* initial) {
+  NonlinearFactorGraph graph;
+  const Pose2 odometry(1.0, 0.0, M_PI / 3);
+  graph.addPrior(X(0), Pose2(), kNoise);
+  Pose2 pose;
+  for (size_t i = 0; i < 6; ++i) {
+    graph.emplace_shared<BetweenFactor<Pose2> >(X(i), X((i + 1) % 6), odometry,
+                                                kNoise);
+    initial->insert(X(i), pose.retract(Vector3(0.1, -0.1, 0.05 * i)));
+    pose = pose * odometry;
+  }
+  return graph;
+}
+// A between factor that can be switched off, to test inactive factors
+class SwitchableBetween : public BetweenFactor<Pose2> {
+ public:
+  std::shared_ptr<bool> enabled = std::make_shared<bool>(true);
+  using BetweenFactor<Pose2>::BetweenFactor;
+  bool active(const Values&) const override { return *enabled; }
+};
+}  // namespace
+
+/* ************************************************************************* */
+TEST(CompiledFactorGraph, structure) {
+  Values initial;
+  const NonlinearFactorGraph graph = createLoop(&initial);
+  const Ordering ordering{X(5), X(4), X(3), X(2), X(1), X(0)};
+  const CompiledFactorGraph compiled(graph, initial, ordering);
+
+  EXPECT_LONGS_EQUAL(6, compiled.nrVariables());
+  EXPECT_LONGS_EQUAL(18, compiled.dim());
+  EXPECT_LONGS_EQUAL(5, compiled.index(X(0)));
+  EXPECT_LONGS_EQUAL(15, compiled.columnOffset(5));
+  EXPECT_LONGS_EQUAL(3, compiled.variableDim(5));
+  CHECK_EXCEPTION(compiled.index(X(6)), std::out_of_range);
+
+  // The precomputed solve agrees with elimination
+  const GaussianFactorGraph::shared_ptr linear = compiled.linearize(initial);
+  EXPECT(assert_equal(*graph.linearize(initial), *linear));
+  EXPECT(assert_equal(linear->optimize(), compiled.solve(*linear), 1e-7));
+
+  // Damping is added to the diagonal of the normal equations
+  const Vector damping = compiled.damping(2.0);
+  EXPECT(assert_equal(Vector::Constant(18, 2.0), damping));
+  const auto [H, eta] = linear->hessian(ordering);
+  const Vector expected = (H + Matrix(damping.asDiagonal())).ldlt().solve(eta);
+  const VectorValues actual = compiled.solve(*linear, damping);
+  for (size_t i = 0; i < ordering.size(); ++i)
+    EXPECT(assert_equal(Vector(expected.segment(3 * i, 3)),
+                        actual.at(ordering[i]), 1e-7));
+
+  // The ordering has to contain every key
+  CHECK_EXCEPTION(CompiledFactorGraph(graph, initial, Ordering{X(0), X(1)}),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(CompiledFactorGraph, inactiveFactor) {
+  Values initial;
+  const NonlinearFactorGraph loop = createLoop(&initial);
+  NonlinearFactorGraph graph = loop;
+  auto chord = std::make_shared<SwitchableBetween>(
+      X(0), X(3), Pose2(2.0, 0.0, M_PI), kNoise);
+  graph.push_back(chord);
+
+  // Compiled while the chord is inactive, its block is still analyzed
+  *chord->enabled = false;
+  const CompiledFactorGraph compiled(graph, initial);
+  GaussianFactorGraph::shared_ptr linear = compiled.linearize(initial);
+  EXPECT(!linear->back());
+  EXPECT(assert_equal(loop.linearize(initial)->optimize(),
+                      compiled.solve(*linear), 1e-7));
+
+  // Once active, it contributes to the normal equations
+  *chord->enabled = true;
+  linear = compiled.linearize(initial);
+  EXPECT(linear->back());
+  EXPECT(assert_equal(graph.linearize(initial)->optimize(),
+                      compiled.solve(*linear), 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(CompiledFactorGraph, optimizers) {
+  Values initial;
+  const NonlinearFactorGraph graph = createLoop(&initial);
+  auto compiled = std::make_shared<CompiledFactorGraph>(graph, initial);
+
+  const Values expectedGN = GaussNewtonOptimizer(graph, initial).optimize();
+  EXPECT(assert_equal(expectedGN,
+                      GaussNewtonOptimizer(compiled, initial).optimize(), 1e-6));
+
+  LevenbergMarquardtParams params;
+  const Values expectedLM =
+      LevenbergMarquardtOptimizer(graph, initial, params).optimize();
+  EXPECT(assert_equal(
+      expectedLM,
+      LevenbergMarquardtOptimizer(compiled, initial, params).optimize(), 1e-6));
+  params.diagonalDamping = true;
+  EXPECT(assert_equal(
+      LevenbergMarquardtOptimizer(graph, initial, params).optimize(),
+      LevenbergMarquardtOptimizer(compiled, initial, params).optimize(), 1e-6));
+
+  EXPECT(assert_equal(DoglegOptimizer(graph, initial).optimize(),
+                      DoglegOptimizer(compiled, initial).optimize(), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -802,6 +802,260 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, deadline) {
+  ISAM2Params params;
+  params.relinearizeSkip = 2;
+  ISAM2 isam(params);
+
+  // A chain of poses with a poor initial estimate
+  NonlinearFactorGraph graph;
+  Values initial;
+  const auto noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  graph.addPrior(0, Pose2(), noise);
+  initial.insert(0, Pose2(0.5, 0.5, 0.5));
+  for (size_t i = 1; i < 5; ++i) {
+    graph.emplace_shared<BetweenFactor<Pose2>>(i - 1, i, Pose2(1, 0, 0), noise);
+    initial.insert(i, Pose2(i + 0.5, -0.5, -0.5));
+  }
+  isam.update(graph, initial);
+
+  // A deadline that has passed defers all relinearization
+  NonlinearFactorGraph newFactors;
+  newFactors.emplace_shared<BetweenFactor<Pose2>>(4, 5, Pose2(1, 0, 0), noise);
+  Values newValues;
+  newValues.insert(5, Pose2(5, 0, 0));
+  ISAM2UpdateParams updateParams;
+  updateParams.deadline = std::chrono::steady_clock::now();
+  ISAM2Result result = isam.update(newFactors, newValues, updateParams);
+  EXPECT(result.deferredKeys.exists(1));
+  EXPECT(assert_equal(initial.at<Pose2>(1),
+                      isam.getLinearizationPoint().at<Pose2>(1)));
+
+  // The deferred variables are relinearized in the next update, even though
+  // it is not a relinearization step
+  result = isam.update();
+  EXPECT(result.deferredKeys.empty());
+  EXPECT(result.variablesRelinearized > 0);
+  EXPECT(std::abs(isam.getLinearizationPoint().at<Pose2>(1).theta()) < 0.25);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, optimizeWildfireParallel) {
+  ISAM2 isam = createSlamlikeISAM2();
+
+  // Back-substitute from a zero delta, with the root clique replaced
+  VectorValues expected = isam.getDelta(), actual = isam.getDelta();
+  expected.setZero();
+  actual.setZero();
+  const ISAM2::sharedClique& root = isam.roots().front();
+  const KeySet replaced(root->conditional()->beginFrontals(),
+                        root->conditional()->endFrontals());
+  KeySet expectedChanged, actualChanged;
+  const size_t expectedCount = optimizeWildfireNonRecursive(
+      root, 0.001, replaced, &expected, &expectedChanged);
+  EXPECT_LONGS_EQUAL(expectedCount,
+                     optimizeWildfireParallel(root, 0.001, replaced, &actual,
+                                              &actualChanged));
+  EXPECT(expectedCount > root->conditional()->nrFrontals());
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(expectedChanged.exists(root->conditional()->front()));
+  EXPECT(assert_container_equality(expectedChanged, actualChanged));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, cachedNonlinearError) {
+  ISAM2Params params;
+  params.relinearizeSkip = 1;
+  params.evaluateNonlinearError = true;
+  ISAM2 isam(params);
+
+  // Grow a chain of poses with a loop closure, and check the errors at every
+  // step against a full evaluation
+  const auto noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  NonlinearFactorGraph graph;
+  for (size_t i = 0; i < 8; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (i == 0)
+      newFactors.addPrior(0, Pose2(), noise);
+    else
+      newFactors.emplace_shared<BetweenFactor<Pose2>>(i - 1, i,
+                                                      Pose2(1, 0, M_PI_4), noise);
+    if (i == 7)
+      newFactors.emplace_shared<BetweenFactor<Pose2>>(7, 0, Pose2(1, 0, M_PI_4),
+                                                      noise);
+    newValues.insert(i, Pose2(i + 0.1, 0.2 * i, 0.1 * i));
+
+    Values estimate = isam.calculateEstimate();
+    estimate.insert(newValues);
+    graph.push_back(newFactors);
+    const ISAM2Result result = isam.update(newFactors, newValues);
+    EXPECT_DOUBLES_EQUAL(graph.error(estimate), *result.errorBefore, 1e-9);
+    EXPECT_DOUBLES_EQUAL(graph.error(isam.calculateEstimate()),
+                         *result.errorAfter, 1e-9);
+  }
+
+  // Removing a factor removes its error
+  ISAM2UpdateParams updateParams;
+  updateParams.removeFactorIndices.push_back(8);
+  const ISAM2Result result =
+      isam.update(NonlinearFactorGraph(), Values(), updateParams);
+  graph.remove(8);
+  EXPECT_DOUBLES_EQUAL(graph.error(isam.calculateEstimate()),
+                       *result.errorAfter, 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, cacheOrderings) {
+  // Relinearize everything in every update, so that all updates are batch
+  // steps; the updates without new factors repeat the previous topology
+  ISAM2Params params(ISAM2GaussNewtonParams(), 0.0, 1);
+  ISAM2 isam(params);
+  params.cacheOrderings = true;
+  ISAM2 cached(params);
+
+  const auto noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  for (size_t i = 0; i < 10; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (i == 0)
+      newFactors.addPrior(0, Pose2(), noise);
+    else
+      newFactors.emplace_shared<BetweenFactor<Pose2>>(i - 1, i,
+                                                      Pose2(1, 0, M_PI_4), noise);
+    if (i % 4 == 3)
+      newFactors.emplace_shared<BetweenFactor<Pose2>>(i - 3, i,
+                                                      Pose2(1, 2, M_PI), noise);
+    newValues.insert(i, Pose2(i + 0.1, 0.2 * i, 0.1 * i));
+
+    isam.update(newFactors, newValues);
+    cached.update(newFactors, newValues);
+    for (size_t j = 0; j < 2; ++j) {
+      isam.update();
+      cached.update();
+    }
+    EXPECT(assert_equal(isam.calculateEstimate(), cached.calculateEstimate(),
+                        1e-6));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, compactFactorSlots) {
+  ISAM2Params params;
+  params.evaluateNonlinearError = true;
+  params.factorSlotCompactionThreshold = 0.25;
+  ISAM2 isam(params);
+
+  // A chain of poses, with a second factor on every edge
+  const auto noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  NonlinearFactorGraph graph;
+  Values values;
+  graph.addPrior(0, Pose2(), noise);
+  values.insert(0, Pose2());
+  for (size_t i = 1; i < 5; ++i) {
+    graph.emplace_shared<BetweenFactor<Pose2>>(i - 1, i, Pose2(1, 0, 0), noise);
+    graph.emplace_shared<BetweenFactor<Pose2>>(i - 1, i, Pose2(1, 0, 0.1), noise);
+    values.insert(i, Pose2(i, 0, 0));
+  }
+  isam.update(graph, values);
+
+  // Removing two factors leaves holes below the threshold
+  ISAM2UpdateParams updateParams;
+  updateParams.removeFactorIndices = {2, 4};
+  ISAM2Result result = isam.update(NonlinearFactorGraph(), Values(), updateParams);
+  EXPECT(!result.factorSlotRemap);
+  EXPECT_LONGS_EQUAL(2, isam.nrEmptyFactorSlots());
+
+  // A third one triggers compaction, new factors get compacted indices
+  NonlinearFactorGraph newFactors;
+  newFactors.emplace_shared<BetweenFactor<Pose2>>(4, 5, Pose2(1, 0, 0), noise);
+  Values newValues;
+  newValues.insert(5, Pose2(5, 0, 0));
+  updateParams.removeFactorIndices = {6};
+  result = isam.update(newFactors, newValues, updateParams);
+  CHECK(result.factorSlotRemap);
+  const FactorIndices& remap = *result.factorSlotRemap;
+  EXPECT_LONGS_EQUAL(10, remap.size());
+  EXPECT_LONGS_EQUAL(ISAM2::kRemovedFactorSlot, remap[2]);
+  EXPECT_LONGS_EQUAL(2, remap[3]);
+  EXPECT_LONGS_EQUAL(4, remap[7]);
+  EXPECT_LONGS_EQUAL(6, remap[9]);
+  EXPECT_LONGS_EQUAL(6, result.newFactorsIndices[0]);
+  EXPECT_LONGS_EQUAL(0, isam.nrEmptyFactorSlots());
+  EXPECT_LONGS_EQUAL(7, isam.getFactorsUnsafe().size());
+  EXPECT(assert_equal(VariableIndex(isam.getFactorsUnsafe()),
+                      isam.getVariableIndex()));
+
+  // Later updates use the new indices, and the cached errors moved along:
+  // remove the second factor between 3 and 4, formerly in slot 8
+  updateParams.removeFactorIndices = {5};
+  result = isam.update(NonlinearFactorGraph(), Values(), updateParams);
+  NonlinearFactorGraph expected = isam.getFactorsUnsafe();
+  EXPECT(!expected[5]);
+  EXPECT_DOUBLES_EQUAL(expected.error(isam.calculateEstimate()),
+                       *result.errorAfter, 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, compactFactorSlotsWithoutLinearCache) {
+  // The same chain of poses in two ISAM2 instances, one of them compacts
+  ISAM2Params params;
+  params.cacheLinearizedFactors = false;
+  ISAM2 isam(params);
+  params.factorSlotCompactionThreshold = 0.2;
+  ISAM2 compacting(params);
+
+  const auto noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  NonlinearFactorGraph graph;
+  Values values;
+  FastMap<Key, int> constrainedKeys;
+  graph.addPrior(0, Pose2(), noise);
+  for (size_t i = 0; i < 6; ++i) {
+    if (i > 0)
+      graph.emplace_shared<BetweenFactor<Pose2>>(i - 1, i, Pose2(1, 0, 0.1),
+                                                 noise);
+    values.insert(i, Pose2(i + 0.1, 0.1, 0.1 * i));
+    constrainedKeys[i] = i == 0 ? 0 : 1;
+  }
+  isam.update(graph, values, FactorIndices(), constrainedKeys);
+  compacting.update(graph, values, FactorIndices(), constrainedKeys);
+
+  // Marginalizing the first pose empties two slots and appends the marginal,
+  // only to the nonlinear factors as linear factors are not cached
+  isam.marginalizeLeaves(FastList<Key>{0});
+  compacting.marginalizeLeaves(FastList<Key>{0});
+  EXPECT_LONGS_EQUAL(2, compacting.nrEmptyFactorSlots());
+
+  NonlinearFactorGraph newFactors;
+  newFactors.emplace_shared<BetweenFactor<Pose2>>(5, 6, Pose2(1, 0, 0.1), noise);
+  Values newValues;
+  newValues.insert(6, Pose2(6.1, 0.1, 0.6));
+  isam.update(newFactors, newValues);
+  const ISAM2Result result = compacting.update(newFactors, newValues);
+  CHECK(result.factorSlotRemap);
+  EXPECT_LONGS_EQUAL(0, compacting.nrEmptyFactorSlots());
+  EXPECT(assert_equal(VariableIndex(compacting.getFactorsUnsafe()),
+                      compacting.getVariableIndex()));
+  EXPECT(assert_equal(isam.calculateEstimate(), compacting.calculateEstimate(),
+                      1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, memoryUsage) {
+  ISAM2 isam = createSlamlikeISAM2();
+  const MemoryUsage usage = isam.memoryUsage();
+  for (const std::string component :
+       {"conditionals", "cachedFactors", "cliques", "nodes", "linearFactors",
+        "nonlinearFactorSlots", "variableIndex", "delta", "theta.gtsam::Pose2"})
+    EXPECT(usage.bytes(component) > 0);
+
+  // The conditionals hold at least the nonzeros of R
+  const size_t nnz = isam.roots().front()->calculate_nnz();
+  EXPECT(usage.bytes("conditionals") >= nnz * sizeof(double));
+  EXPECT(usage.total() > usage.bytes("conditionals"));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
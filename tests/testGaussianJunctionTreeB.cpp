@@ -43,6 +43,7 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <cmath>
+#include <functional>
 #include <list>
 #include <utility>
 #include <vector>
@@ -124,6 +125,42 @@ TEST(GaussianJunctionTreeB, OptimizeMultiFrontal) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianJunctionTreeB, relaxedAmalgamation) {
+  const auto [nlfg, values] = createNonlinearSmoother(7);
+  const GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+  const Ordering ordering {X(1), X(3), X(5), X(7), X(2), X(6), X(4)};
+  const GaussianEliminationTree etree(*fg, ordering);
+
+  // Allowing any number of zeros merges the whole smoother into one clique
+  const GaussianJunctionTree merged(etree, AmalgamationParams(1.0));
+  LONGS_EQUAL(1, merged.roots().size());
+  const GaussianJunctionTree::sharedNode root = merged.roots().front();
+  EXPECT_LONGS_EQUAL(0, root->children.size());
+  EXPECT_LONGS_EQUAL(7, root->orderedFrontalKeys.size());
+  EXPECT_LONGS_EQUAL(fg->size(), root->factors.size());
+
+  // Relaxed amalgamation does not grow cliques beyond maxFrontals
+  const GaussianJunctionTree limited(etree, AmalgamationParams(1.0, 4));
+  size_t nrCliques = 0;
+  std::function<void(const GaussianJunctionTree::sharedNode&)> check =
+      [&](const GaussianJunctionTree::sharedNode& node) {
+        ++nrCliques;
+        EXPECT(node->orderedFrontalKeys.size() <= 4);
+        for (const auto& child : node->children) check(child);
+      };
+  for (const auto& root : limited.roots()) check(root);
+  EXPECT(nrCliques > 1 && nrCliques < 4);
+
+  // The merged cliques store zeros, but the solution is the same
+  const VectorValues expected =
+      GaussianJunctionTree(etree).eliminate(EliminateQR).first->optimize();
+  EXPECT(assert_equal(expected, merged.eliminate(EliminateQR).first->optimize()));
+  EXPECT(assert_equal(expected,
+                      merged.eliminate(EliminatePreferCholesky).first->optimize()));
+  EXPECT(assert_equal(expected, limited.eliminate(EliminateQR).first->optimize()));
+}
+
 /* ************************************************************************* */
 TEST(GaussianJunctionTreeB, optimizeMultiFrontal2) {
   // create a graph
@@ -258,6 +258,54 @@ TEST(Marginals, order) {
   testMarginals(marginals, set);
 }
 
+/* ************************************************************************* */
+TEST(Marginals, covarianceBlocks) {
+  // A pose chain with a loop closure, and landmarks each seen from one pose
+  NonlinearFactorGraph graph;
+  Values values;
+  const SharedDiagonal odometryNoise = noiseModel::Diagonal::Sigmas(Vector3(0.2, 0.2, 0.1));
+  const SharedDiagonal measurementNoise = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2));
+  graph.addPrior(Symbol('x', 0), Pose2(), odometryNoise);
+  for (size_t i = 0; i < 6; ++i) {
+    const Pose2 pose(2.0 * i, 0.0, 0.0);
+    const Point2 landmark(2.0 * i, 2.0);
+    values.insert(Symbol('x', i), pose);
+    values.insert(Symbol('l', i), landmark);
+    if (i > 0)
+      graph.emplace_shared<BetweenFactor<Pose2>>(Symbol('x', i - 1), Symbol('x', i),
+                                                 Pose2(2.0, 0.0, 0.0), odometryNoise);
+    graph.emplace_shared<BearingRangeFactor<Pose2, Point2>>(
+        Symbol('x', i), Symbol('l', i), pose.bearing(landmark), pose.range(landmark),
+        measurementNoise);
+  }
+  graph.emplace_shared<BetweenFactor<Pose2>>(Symbol('x', 0), Symbol('x', 5),
+                                             Pose2(10.0, 0.0, 0.0), odometryNoise);
+
+  // Landmarks first, each one ends up in its own leaf clique
+  Ordering ordering;
+  for (size_t i = 0; i < 6; ++i) ordering.push_back(Symbol('l', i));
+  for (size_t i = 0; i < 6; ++i) ordering.push_back(Symbol('x', i));
+
+  const vector<pair<Key, Key>> pairs{{Symbol('l', 2), Symbol('x', 2)},
+                                     {Symbol('x', 0), Symbol('x', 5)},
+                                     {Symbol('x', 5), Symbol('x', 1)}};
+  for (auto factorization : {Marginals::CHOLESKY, Marginals::QR}) {
+    const Marginals marginals(graph, values, ordering, factorization);
+    const GaussianBayesTree::CovarianceBlocks blocks = marginals.covarianceBlocks(pairs);
+    EXPECT_LONGS_EQUAL(values.size() + pairs.size(), blocks.size());
+    for (Key key : values.keys())
+      EXPECT(assert_equal(marginals.marginalCovariance(key), blocks.at({key, key}), 1e-8));
+    for (const auto& [i, j] : pairs) {
+      const JointMarginal joint = marginals.jointMarginalCovariance({i, j});
+      EXPECT(assert_equal(Matrix(joint(i, j)), blocks.at({i, j}), 1e-8));
+    }
+
+    // Two landmarks never share a clique
+    CHECK_EXCEPTION(marginals.covarianceBlocks({{Symbol('l', 0), Symbol('l', 3)}}),
+                    std::invalid_argument);
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -23,8 +23,10 @@
 #include <tests/smallExample.h>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/sam/RangeFactor.h>
@@ -63,6 +65,20 @@ TEST( NonlinearFactorGraph, error )
   DOUBLES_EQUAL( 5.625, actual2, 1e-9 );
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, factorErrors )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactor::shared_ptr());  // null factors have zero error
+  Values c2 = createNoisyValues();
+  Vector actual = fg.factorErrors(c2);
+  LONGS_EQUAL(fg.size(), actual.size());
+  for (size_t i = 0; i + 1 < fg.size(); i++)
+    DOUBLES_EQUAL(fg[i]->error(c2), actual[i], 1e-9);
+  DOUBLES_EQUAL(0.0, actual[fg.size() - 1], 0.0);
+  DOUBLES_EQUAL(fg.error(c2), actual.sum(), 1e-9);
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, keys )
 {
@@ -131,6 +147,81 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+namespace {
+// Factors that opt in to in-place linearization, on the example values
+NonlinearFactorGraph createInPlaceGraph() {
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(2, 0.1);
+  NonlinearFactorGraph fg;
+  fg.addPrior(X(1), Point2(0, 0), model);
+  fg.emplace_shared<BetweenFactor<Point2> >(X(1), X(2), Point2(1.5, 0), model);
+  fg.emplace_shared<BetweenFactor<Point2> >(X(1), L(1), Point2(0, -1), model);
+  fg.emplace_shared<BetweenFactor<Point2> >(X(2), L(1), Point2(-1.5, -1), model);
+  fg.emplace_shared<ExpressionFactor<Point2> >(model, Point2(0, -1),
+                                               Expression<Point2>(L(1)));
+  return fg;
+}
+
+// Linearizes to something else than the Jacobian of its error, like factors
+// with a custom linearize() such as GeneralSFMFactor or TriangulationFactor
+class CustomLinearizeFactor : public BetweenFactor<Point2> {
+ public:
+  using BetweenFactor<Point2>::BetweenFactor;
+  GaussianFactor::shared_ptr linearize(const Values& /*x*/) const override {
+    return std::make_shared<JacobianFactor>(key1(), 2.0 * I_2x2, key2(),
+                                            -2.0 * I_2x2, Vector2(1, 1));
+  }
+};
+}  // namespace
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeArena )
+{
+  NonlinearFactorGraph fg = createInPlaceGraph();
+  const Values initial = createNoisyValues(), truth = createValues();
+
+  LinearizationArena arena;
+  GaussianFactorGraph::shared_ptr linear = fg.linearize(initial, arena);
+  EXPECT(assert_equal(*fg.linearize(initial), *linear));
+  EXPECT_LONGS_EQUAL(fg.size(), arena.nrAllocated());
+  EXPECT_LONGS_EQUAL(0, arena.nrReused());
+  const GaussianFactor* first = (*linear)[0].get();
+
+  // Once released, the same factors are overwritten in place
+  linear.reset();
+  linear = fg.linearize(truth, arena);
+  EXPECT(assert_equal(*fg.linearize(truth), *linear));
+  EXPECT_LONGS_EQUAL(0, arena.nrAllocated());
+  EXPECT_LONGS_EQUAL(fg.size(), arena.nrReused());
+  EXPECT(first == (*linear)[0].get());
+
+  // A graph that is still held is left untouched
+  GaussianFactorGraph::shared_ptr linear2 = fg.linearize(initial, arena);
+  EXPECT(linear != linear2);
+  EXPECT_LONGS_EQUAL(fg.size(), arena.nrAllocated());
+  EXPECT(assert_equal(*fg.linearize(truth), *linear));
+  EXPECT(assert_equal(*fg.linearize(initial), *linear2));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeArenaCustomLinearize )
+{
+  // Neither a derived class with its own linearize() nor a factor that did
+  // not opt in is linearized in place
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.emplace_shared<CustomLinearizeFactor>(X(1), X(2), Point2(1.5, 0),
+                                           noiseModel::Unit::Create(2));
+  const Values values = createNoisyValues();
+
+  LinearizationArena arena;
+  fg.linearize(values, arena);
+  const GaussianFactorGraph::shared_ptr linear = fg.linearize(values, arena);
+  EXPECT_LONGS_EQUAL(0, arena.nrReused());
+  EXPECT_LONGS_EQUAL(fg.size(), arena.nrAllocated());
+  EXPECT(assert_equal(*fg.linearize(values), *linear));
+  EXPECT(assert_equal(*fg.back()->linearize(values), *linear->back()));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
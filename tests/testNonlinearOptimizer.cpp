@@ -179,6 +179,21 @@ TEST( NonlinearOptimizer, optimization_method )
 
   Values actualMFChol = LevenbergMarquardtOptimizer(fg, c0, paramsChol).optimize();
   DOUBLES_EQUAL(0,fg.error(actualMFChol),tol);
+
+  LevenbergMarquardtParams paramsSparse;
+  paramsSparse.linearSolverType = LevenbergMarquardtParams::CHOLMOD;
+  Values actualSparse = LevenbergMarquardtOptimizer(fg, c0, paramsSparse).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualSparse),tol);
+
+  LevenbergMarquardtParams paramsMixed;
+  paramsMixed.linearSolverType = LevenbergMarquardtParams::MULTIFRONTAL_CHOLESKY_MIXED;
+  Values actualMixed = LevenbergMarquardtOptimizer(fg, c0, paramsMixed).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualMixed),tol);
+
+  GaussNewtonParams paramsGNSparse;
+  paramsGNSparse.linearSolverType = GaussNewtonParams::CHOLMOD;
+  Values actualGNSparse = GaussNewtonOptimizer(fg, c0, paramsGNSparse).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualGNSparse),tol);
 }
 
 /* ************************************************************************* */
@@ -347,6 +362,81 @@ TEST_UNSAFE(NonlinearOptimizer, MoreOptimization) {
   }
 }
 
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, reuseLinearization) {
+  NonlinearFactorGraph fg;
+  fg.addPrior(0, Pose2(0, 0, 0), noiseModel::Isotropic::Sigma(3, 1));
+  fg.emplace_shared<BetweenFactor<Pose2>>(0, 1, Pose2(1, 0, M_PI / 2),
+      noiseModel::Isotropic::Sigma(3, 1));
+  fg.emplace_shared<BetweenFactor<Pose2>>(1, 2, Pose2(1, 0, M_PI / 2),
+      noiseModel::Isotropic::Sigma(3, 1));
+
+  Values init;
+  init.insert(0, Pose2(3, 4, -M_PI));
+  init.insert(1, Pose2(10, 2, -M_PI));
+  init.insert(2, Pose2(11, 7, -M_PI));
+
+  // Overwriting the previous linearization in place gives the same result
+  LevenbergMarquardtParams lmParams;
+  const Values expectedLM = LevenbergMarquardtOptimizer(fg, init, lmParams).optimize();
+  lmParams.reuseLinearization = true;
+  EXPECT(assert_equal(expectedLM,
+                      LevenbergMarquardtOptimizer(fg, init, lmParams).optimize(), 1e-12));
+
+  GaussNewtonParams gnParams;
+  const Values expectedGN = GaussNewtonOptimizer(fg, init, gnParams).optimize();
+  gnParams.reuseLinearization = true;
+  EXPECT(assert_equal(expectedGN,
+                      GaussNewtonOptimizer(fg, init, gnParams).optimize(), 1e-12));
+
+  DoglegParams dlParams;
+  const Values expectedDL = DoglegOptimizer(fg, init, dlParams).optimize();
+  dlParams.reuseLinearization = true;
+  EXPECT(assert_equal(expectedDL,
+                      DoglegOptimizer(fg, init, dlParams).optimize(), 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, LMSolveDamped) {
+  // Small pose graph with a loop closure
+  NonlinearFactorGraph fg;
+  auto model = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05));
+  fg.addPrior(X(0), Pose2(0, 0, 0), model);
+  for (size_t i = 0; i < 4; i++)
+    fg.emplace_shared<BetweenFactor<Pose2>>(X(i), X(i + 1), Pose2(1, 0, M_PI_2), model);
+  fg.emplace_shared<BetweenFactor<Pose2>>(X(4), X(0), Pose2(0, 0, M_PI_2), model);
+
+  Values init;
+  for (size_t i = 0; i < 5; i++)
+    init.insert(X(i), Pose2(0.1 * i, 0.2, 0.3 * i));
+
+  for (bool diagonalDamping : {false, true}) {
+    LevenbergMarquardtParams params;
+    params.diagonalDamping = diagonalDamping;
+    LevenbergMarquardtOptimizer optimizer(fg, init, params);
+
+    GaussianFactorGraph::shared_ptr linear = optimizer.linearize();
+    VectorValues sqrtHessianDiagonal = linear->hessianDiagonal();
+    for (auto& [key, value] : sqrtHessianDiagonal) value = value.cwiseSqrt();
+
+    // Damping during elimination is the same as eliminating the damped graph
+    const VectorValues expected =
+        optimizer.buildDampedSystem(*linear, sqrtHessianDiagonal)
+            .optimize(*optimizer.params().ordering);
+    EXPECT(assert_equal(expected, optimizer.solveDamped(*linear, sqrtHessianDiagonal)));
+
+    // Again, with the structure cached by the previous call
+    EXPECT(assert_equal(expected, optimizer.solveDamped(*linear, sqrtHessianDiagonal)));
+
+    // Whole optimization, against QR on the damped graph
+    LevenbergMarquardtParams qrParams = params;
+    qrParams.linearSolverType = NonlinearOptimizerParams::MULTIFRONTAL_QR;
+    LevenbergMarquardtOptimizer qrOptimizer(fg, init, qrParams);
+    EXPECT(assert_equal(qrOptimizer.optimize(), optimizer.optimize(), 1e-6));
+    EXPECT_LONGS_EQUAL(qrOptimizer.iterations(), optimizer.iterations());
+  }
+}
+
 /* ************************************************************************* */
 TEST(NonlinearOptimizer, Pose2OptimizationWithHuberNoOutlier) {
 
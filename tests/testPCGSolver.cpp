@@ -19,6 +19,7 @@
 #include <tests/smallExample.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/inference/Symbol.h>
@@ -120,6 +121,33 @@ TEST( GaussianFactorGraphSystem, multiply_getb)
   EXPECT(assert_equal(expectedb, actualb, 1e-3));
 }
 
+/* ************************************************************************* */
+// Test the matrix-free product against the dense Hessian, with mixed factor types
+TEST(GaussianFactorGraphSystem, multiplyMixedFactors) {
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.3));
+  gfg.emplace_shared<JacobianFactor>(0, (Matrix(2, 3) << 1, 2, 3, 4, 5, 6).finished(),
+                                     Vector2(1, 2), model);
+  gfg.emplace_shared<JacobianFactor>(
+      2, (Matrix(2, 2) << 1, 0, 1, 1).finished(), 0,
+      (Matrix(2, 3) << 0, 1, 0, 1, 0, 2).finished(), Vector2(3, 4), model);
+  gfg.emplace_shared<HessianFactor>(JacobianFactor(
+      1, (Matrix(2, 2) << 2, 1, 0, 3).finished(), 2, I_2x2, Vector2(5, 6)));
+  gfg.emplace_shared<JacobianFactor>(1, I_2x2, Vector2(0, 1), model);
+
+  const Ordering ordering{2, 0, 1};
+  const KeyInfo keyInfo(gfg, ordering);
+  DummyPreconditioner dummyPreconditioner;
+  const std::map<Key, Vector> lambda;
+  GaussianFactorGraphSystem system(gfg, dummyPreconditioner, keyInfo, lambda);
+
+  const Vector x = Vector::LinSpaced(7, -1.0, 2.0);
+  Vector actual;
+  system.multiply(x, actual);
+  const Matrix H = gfg.hessian(ordering).first;
+  EXPECT(assert_equal(Vector(H * x), actual, 1e-9));
+}
+
 /* ************************************************************************* */
 // Test Dummy Preconditioner
 TEST(PCGSolver, dummy) {
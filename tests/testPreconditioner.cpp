@@ -23,6 +23,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/IterativeSolver.h>
 #include <gtsam/geometry/Point2.h>
 
 using namespace std;
@@ -122,6 +123,105 @@ TEST(PCGSolver, simpleLinearSystem) {
   EXPECT(assert_equal(expectedSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
 
+  // With incomplete Cholesky preconditioner
+  pcg->preconditioner_ = std::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIC = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGIC, 1e-5));
+}
+
+/* ************************************************************************* */
+namespace {
+// Chain, optionally with a loop closure whose fill-in IC(0) drops
+GaussianFactorGraph createLoop(bool closeLoop = true) {
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.3));
+  gfg.emplace_shared<JacobianFactor>(0, 2 * I_2x2, Vector2(1, 2), model);
+  for (Key j = 0; j < 5; ++j)
+    gfg.emplace_shared<JacobianFactor>(j, -I_2x2, j + 1,
+                                       (Matrix(2, 2) << 1, 0.2, 0, 1).finished(),
+                                       Vector2(0.5 * j, -1.0), model);
+  if (closeLoop)
+    gfg.emplace_shared<JacobianFactor>(5, -I_2x2, 0, I_2x2, Vector2(2, 1), model);
+  return gfg;
+}
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, incompleteCholesky) {
+  const GaussianFactorGraph gfg = createLoop();
+  const KeyInfo keyInfo(gfg);
+  IncompleteCholeskyPreconditioner preconditioner;
+  preconditioner.build(gfg, keyInfo, std::map<Key, Vector>());
+  EXPECT_DOUBLES_EQUAL(0.0, preconditioner.shift(), 1e-12);
+
+  // L^{-T} L^{-1} is symmetric, and exact where the Hessian has no fill-in
+  const Matrix H = gfg.hessian(keyInfo.ordering()).first;
+  const size_t n = H.rows();
+  Matrix Minv(n, n);
+  for (size_t i = 0; i < n; ++i) {
+    Vector y, z;
+    preconditioner.solve(Vector::Unit(n, i), y);
+    preconditioner.transposeSolve(y, z);
+    Minv.col(i) = z;
+  }
+  EXPECT(assert_equal(Matrix(Minv.transpose()), Minv, 1e-9));
+
+  // On a chain there is no fill-in, so IC(0) is the exact Cholesky factor
+  const GaussianFactorGraph chain = createLoop(false);
+  const KeyInfo chainInfo(chain);
+  preconditioner.build(chain, chainInfo, std::map<Key, Vector>());
+  const Matrix Hchain = chain.hessian(chainInfo.ordering()).first;
+  Vector x, z, b = Vector::LinSpaced(Hchain.rows(), 1.0, 2.0);
+  preconditioner.solve(b, x);
+  preconditioner.transposeSolve(x, z);
+  EXPECT(assert_equal(Vector(Hchain.llt().solve(b)), z, 1e-9));
+
+  // PCG converges to the direct solution
+  PCGSolverParameters pcg;
+  pcg.setMaxIterations(100);
+  pcg.setEpsilon_abs(0.0);
+  pcg.setEpsilon_rel(0.0);
+  pcg.preconditioner_ = std::make_shared<IncompleteCholeskyPreconditionerParameters>();
+  EXPECT(assert_equal(gfg.optimize(), PCGSolver(pcg).optimize(gfg), 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, blockJacobiReuse) {
+  const GaussianFactorGraph gfg = createLoop();
+  const KeyInfo keyInfo(gfg);
+
+  // Damped system, as built by Levenberg-Marquardt
+  auto damped = [&](double lambda) {
+    GaussianFactorGraph result = gfg;
+    for (Key j = 0; j <= 5; ++j)
+      result.emplace_shared<JacobianFactor>(j, std::sqrt(lambda) * I_2x2,
+                                            Vector2::Zero(),
+                                            noiseModel::Unit::Create(2));
+    return result;
+  };
+
+  BlockJacobiPreconditioner cached, fresh;
+  cached.build(damped(1.0), keyInfo, std::map<Key, Vector>());
+  EXPECT_LONGS_EQUAL(13, cached.nrUpdatedFactors());
+
+  // Only the blocks of the new damping factors are computed
+  const GaussianFactorGraph damped2 = damped(10.0);
+  cached.build(damped2, keyInfo, std::map<Key, Vector>());
+  EXPECT_LONGS_EQUAL(6, cached.nrUpdatedFactors());
+  fresh.build(damped2, keyInfo, std::map<Key, Vector>());
+
+  // The cache does not keep the factors alive
+  const GaussianFactor::shared_ptr factor = damped2.back();
+  EXPECT_LONGS_EQUAL(2, factor.use_count());
+
+  const Vector b = Vector::LinSpaced(12, -1.0, 1.0);
+  Vector expected(12), actual(12);
+  fresh.solve(b, expected);
+  cached.solve(b, actual);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+  fresh.transposeSolve(b, expected);
+  cached.transposeSolve(b, actual);
+  EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
 /* ************************************************************************* */
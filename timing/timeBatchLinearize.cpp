@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBatchLinearize.cpp
+ * @brief   time batch linearization of BetweenFactor<Pose3> against linearize
+ */
+
+#include <gtsam/base/timing.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+int main() {
+  const size_t nrPoses = 100000, nrRepeats = 20;
+
+  // Pose graph with odometry and a loop closure every ten poses
+  Values values;
+  NonlinearFactorGraph graph;
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(6, 0.1);
+  const Pose3 odometry(Rot3::Rodrigues(0.01, 0.02, 0.05), Point3(1, 0.1, 0));
+  Pose3 pose;
+  for (size_t i = 0; i < nrPoses; ++i) {
+    values.insert(X(i), pose);
+    pose = pose * odometry;
+    if (i > 0)
+      graph.emplace_shared<BetweenFactor<Pose3> >(X(i - 1), X(i), odometry, model);
+    if (i >= 10 && i % 10 == 0)
+      graph.emplace_shared<BetweenFactor<Pose3> >(
+          X(i - 10), X(i), values.at<Pose3>(X(i - 10)).between(values.at<Pose3>(X(i))),
+          model);
+  }
+
+  vector<const BetweenFactor<Pose3>*> batch;
+  for (const auto& factor : graph)
+    batch.push_back(static_cast<const BetweenFactor<Pose3>*>(factor.get()));
+  cout << "NOTE:  Times are reported for " << nrRepeats << " linearizations of "
+       << batch.size() << " factors" << endl;
+
+  {
+    gttic_(linearize_each_factor);
+    for (size_t r = 0; r < nrRepeats; ++r) {
+      for (const auto& factor : graph) {
+        GaussianFactor::shared_ptr linear = factor->linearize(values);
+      }
+    }
+  }
+  {
+    gttic_(linearize_graph);
+    for (size_t r = 0; r < nrRepeats; ++r)
+      GaussianFactorGraph::shared_ptr linear = graph.linearize(values);
+  }
+  {
+    gttic_(linearize_batch);
+    JacobianBatch jacobians;
+    for (size_t r = 0; r < nrRepeats; ++r)
+      BetweenFactor<Pose3>::LinearizeBatch(batch, values, jacobians);
+  }
+
+  // Print timings
+  tictoc_print_();
+
+  return 0;
+}
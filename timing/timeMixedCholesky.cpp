@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeMixedCholesky.cpp
+ * @brief   time multifrontal Cholesky in double precision against single
+ *          precision with iterative refinement
+ */
+
+#include <gtsam/base/timing.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+int main(int argc, char* argv[]) {
+  // A cubic lattice of poses, its separators grow with the side squared
+  const size_t side = argc > 1 ? atoi(argv[1]) : 10, nrRepeats = 5;
+  auto index = [side](size_t i, size_t j, size_t k) {
+    return X((i * side + j) * side + k);
+  };
+
+  Values values;
+  NonlinearFactorGraph graph;
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(6, 0.1);
+  graph.addPrior(index(0, 0, 0), Pose3(), model);
+  for (size_t i = 0; i < side; ++i)
+    for (size_t j = 0; j < side; ++j)
+      for (size_t k = 0; k < side; ++k) {
+        const Pose3 pose(Rot3::Rodrigues(0.01 * i, 0.02 * j, 0.03 * k),
+                         Point3(i, j, k));
+        values.insert(index(i, j, k), pose);
+        const Pose3 noisy = pose.retract(0.01 * Vector6::Ones());
+        if (i > 0)
+          graph.emplace_shared<BetweenFactor<Pose3> >(
+              index(i - 1, j, k), index(i, j, k),
+              values.at<Pose3>(index(i - 1, j, k)).between(noisy), model);
+        if (j > 0)
+          graph.emplace_shared<BetweenFactor<Pose3> >(
+              index(i, j - 1, k), index(i, j, k),
+              values.at<Pose3>(index(i, j - 1, k)).between(noisy), model);
+        if (k > 0)
+          graph.emplace_shared<BetweenFactor<Pose3> >(
+              index(i, j, k - 1), index(i, j, k),
+              values.at<Pose3>(index(i, j, k - 1)).between(noisy), model);
+      }
+
+  const GaussianFactorGraph::shared_ptr linear = graph.linearize(values);
+  const Ordering ordering = Ordering::Colamd(*linear);
+  cout << "NOTE:  Times are reported for " << nrRepeats << " solves of "
+       << values.size() << " poses" << endl;
+
+  VectorValues expected, actual;
+  {
+    gttic_(double_precision);
+    for (size_t r = 0; r < nrRepeats; ++r)
+      expected = linear->eliminateMultifrontal(ordering, EliminateCholesky)
+                     ->optimize();
+  }
+  {
+    gttic_(single_precision_refined);
+    for (size_t r = 0; r < nrRepeats; ++r) {
+      const GaussianBayesTree::shared_ptr bayesTree =
+          linear->eliminateMultifrontal(ordering,
+                                        EliminateCholeskySinglePrecision);
+      actual = bayesTree->refine(*linear, bayesTree->optimize());
+    }
+  }
+  cout << "Relative difference of the solutions: "
+       << expected.subtract(actual).norm() / expected.norm() << endl;
+
+  // Print timings
+  tictoc_print_();
+
+  return 0;
+}